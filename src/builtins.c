@@ -0,0 +1,109 @@
+/**
+ * @file builtins.c
+ * Table of builtin functions
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#include "builtins.h"
+
+#include <assert.h>
+#include <string.h>
+
+/**
+ * Makes identifier of builtin function
+ */
+#define BUILTIN(fun_name, param_signature, retval_signature) \
+    { \
+        .name = fun_name, \
+        .type = FUNCTION, \
+        .defined = 1, \
+        .fun = {.param = param_signature, .retval = retval_signature}, \
+    }
+
+/**
+ * Makes an item of perfect hash table for builtin function (the last character is needed for hash)
+ */
+#define BUILTIN_SLOT(fun_name, last, index) [BUILTINS_HASH(sizeof(fun_name) - 1, last)] = {sizeof(fun_name) - 1, index}
+
+/**
+ * Packed codes of lists of types (for static signatures)
+ */
+#define TYPES_1(a) SIGNATURE_CODE(a)
+#define TYPES_2(a, b) (TYPES_1(a) | SIGNATURE_CODE(b) << 2)
+#define TYPES_3(a, b, c) (TYPES_2(a, b) | SIGNATURE_CODE(c) << 4)
+
+/**
+ * Identifiers of builtin functions (signatures are constant, atoms aren't set)
+ */
+static const identifier_t builtins[NUMBER_OF_BUILTINS] = {
+    BUILTIN("reads", SIGNATURE(0, 0), SIGNATURE(1, TYPES_1(VAR_STRING))),
+    BUILTIN("readi", SIGNATURE(0, 0), SIGNATURE(1, TYPES_1(VAR_INTEGER))),
+    BUILTIN("readn", SIGNATURE(0, 0), SIGNATURE(1, TYPES_1(VAR_NUMBER))),
+    BUILTIN("write", SIGNATURE_VARARGS, SIGNATURE(0, 0)),
+    BUILTIN("tointeger", SIGNATURE(1, TYPES_1(VAR_NUMBER)), SIGNATURE(1, TYPES_1(VAR_INTEGER))),
+    BUILTIN("substr", SIGNATURE(3, TYPES_3(VAR_STRING, VAR_NUMBER, VAR_NUMBER)), SIGNATURE(1, TYPES_1(VAR_STRING))),
+    BUILTIN("ord", SIGNATURE(2, TYPES_2(VAR_STRING, VAR_INTEGER)), SIGNATURE(1, TYPES_1(VAR_INTEGER))),
+    BUILTIN("chr", SIGNATURE(1, TYPES_1(VAR_INTEGER)), SIGNATURE(1, TYPES_1(VAR_STRING))),
+};
+
+/**
+ * Slot of the builtins' perfect hash table
+ *
+ * Content:
+ * <ul>
+ *      <li><code>len</code> - Length of the name (0 in empty slot)</li>
+ *      <li><code>index</code> - Index of the function in the table of identifiers</li>
+ * </ul>
+ */
+struct builtins_slot {
+    size_t len;
+    int index;
+};
+
+/**
+ * Perfect hash table of builtin functions (it's fixed at compile time)
+ */
+static const struct builtins_slot builtins_slots[BUILTINS_SLOTS] = {
+    BUILTIN_SLOT("reads", 's', 0),
+    BUILTIN_SLOT("readi", 'i', 1),
+    BUILTIN_SLOT("readn", 'n', 2),
+    BUILTIN_SLOT("write", 'e', 3),
+    BUILTIN_SLOT("tointeger", 'r', 4),
+    BUILTIN_SLOT("substr", 'r', 5),
+    BUILTIN_SLOT("ord", 'd', 6),
+    BUILTIN_SLOT("chr", 'r', 7),
+};
+
+#undef TYPES_3
+#undef TYPES_2
+#undef TYPES_1
+#undef BUILTIN_SLOT
+#undef BUILTIN
+
+int builtins_find(const char *name, size_t len)
+{
+    assert(name || len == 0);
+
+    const struct builtins_slot *slot;
+
+    // Empty slots have zero length, so they can't match (there is no empty name)
+    if (len == 0)
+        return -1;
+
+    slot = &builtins_slots[BUILTINS_HASH(len, name[len - 1])];
+    if (slot->len != len || memcmp(builtins[slot->index].name, name, len) != 0)
+        return -1;
+
+    return slot->index;
+}
+
+const identifier_t *builtins_identifier(int index)
+{
+    assert(0 <= index && index < NUMBER_OF_BUILTINS);
+
+    return &builtins[index];
+}
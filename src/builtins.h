@@ -0,0 +1,63 @@
+/**
+ * @file builtins.h
+ * Header file of table of builtin functions
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _BUILTINS_H_
+#define _BUILTINS_H_
+
+#include "identifier.h"
+
+#include <stdlib.h>
+
+/**
+ * Number of builtin functions
+ */
+#define NUMBER_OF_BUILTINS 8
+
+/**
+ * Number of slots of the builtins' perfect hash table (must be a power of 2)
+ */
+#define BUILTINS_SLOTS 16
+
+/**
+ * Perfect hash function of builtin functions' names (every builtin has its own slot)
+ *
+ * It uses only length and the last character, so it can be used in constant expressions.
+ */
+#define BUILTINS_HASH(len, last) ((4 * (len) + (unsigned char) (last)) & (BUILTINS_SLOTS - 1))
+
+/**
+ * Finds builtin function
+ *
+ * Builtins are defined at compile time (they aren't stored in tables of symbols),
+ * the global scope consults them directly.
+ *
+ * @param name Name of the function (it needn't be null-terminated)
+ * @param len Length of the name
+ * @return Index of the builtin function (lower than NUMBER_OF_BUILTINS) or -1 if there isn't builtin with the name
+ *
+ * @pre name != NULL || len == 0
+ */
+int builtins_find(const char *name, size_t len);
+
+/**
+ * Gets identifier of builtin function
+ *
+ * The table of builtins is constant and shared, so the identifier has no atom
+ * (atoms belong to the interner of the compilation). Users of the identifier
+ * make their own copy with the atom (see symstack_find_global()).
+ *
+ * @param index Index of the builtin function (from builtins_find())
+ * @return Identifier of the builtin function
+ *
+ * @pre 0 <= index && index < NUMBER_OF_BUILTINS
+ */
+const identifier_t *builtins_identifier(int index);
+
+#endif //_BUILTINS_H_
@@ -15,6 +15,9 @@
 #include "kwtable.h"
 #include "string_factory.h"
 #include "symqueue.h"
+#include "strpool.h"
+#include "exprstack.h"
+#include "interner.h"
 
 /**
  * Context for lexical and syntactical analysis
@@ -24,6 +27,16 @@
  *      <li><code>symstack</code> - Pointer to the stack-like storage of tables of symbols</li>
  *      <li><code>kwtable</code> - Pointer to keywords table</li>
  *      <li><code>string</code> - Pointer to temporary string of string factory</li>
+ *      <li><code>param</code> - Types of parameters, arguments or left side of assignment being parsed</li>
+ *      <li><code>retval</code> - Types of return values or right side of assignment being parsed</li>
+ *      <li><code>signatures</code> - Pointer to pool for types of long signatures</li>
+ *      <li><code>scanner</code> - Pointer to scanner state (with input source)</li>
+ *      <li><code>literals</code> - Pointer to pool for string literals (NULL means
+ *          every STRING token has its own allocated string)</li>
+ *      <li><code>interner</code> - Pointer to interner of identifiers' names (atoms of the whole
+ *          compilation come from it)</li>
+ *      <li><code>exprstack</code> - Pointer to stack of the expression parser (it's reused
+ *          by all expressions, so it's cleared at the start of each one)</li>
  * </ul>
  */
 typedef struct context {
@@ -31,10 +44,15 @@ typedef struct context {
     kwtable_t *kwtable;
     string_t *string;
     identifier_t *saved_id;
-    string_t *param;
-    string_t *retval;
+    signature_t param;
+    signature_t retval;
+    signature_pool_t *signatures;
     symqueue_t *main_symqueue;
     symqueue_t *cycle_symqueue;
+    struct scanner *scanner;
+    strpool_t *literals;
+    interner_t *interner;
+    exprstack_t *exprstack;
 } context_t;
 
 #endif // _CONTEXT_H_
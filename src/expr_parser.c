@@ -9,6 +9,7 @@
  */
 
 #include "expr_parser.h"
+#include "precedence_table.h"
 #include "scanner.h"
 #include "exprstack.h"
 #include "token.h"
@@ -41,41 +42,38 @@ char *keywords[] = {
 
 static void print_exprstack(exprstack_t *s)
 {
-    struct exprstack_item *item = s->top;
     char status[513];
     int status_len = 0;
+    size_t stop = 0;
     char *tmp_string;
-    char tmp_char;
 
     memset(status, '\0', 512);
 
-    if (!item) {
+    if (s->count == 0) {
         LOG_DEBUG_M("Exprstack status: completely empty");
         return;
     }
 
-    while (item) {
-        if (item->type == NON_TERM)
-            status[status_len++] = 'N';
-        else if (item->type == STOP)
+    // Items are stored from the bottom, stops are interleaved by their positions
+    // (long stacks are truncated, the longest step writes 16 characters at most)
+    for (size_t i = 0; i <= s->count && status_len < 512 - 16; i++) {
+        for (; stop < s->stop_count && s->stops[stop] == i && status_len < 512 - 16; stop++) {
             status[status_len++] = '|';
-        else if (item->type == TERM) {
-            tmp_string = term_types[item->term_data.type];
-            for (int i = 0; i < (int) strlen(tmp_string); i++) {
-                status[status_len + strlen(tmp_string) - i - 1] = tmp_string[i];
-            }
-            status_len += (int) strlen(tmp_string);
+            status[status_len++] = ' ';
         }
 
-        status[status_len++] = ' ';
+        if (i == s->count)
+            break;
 
-        item = item->prev;
-    }
+        if (s->items[i].type == NON_TERM)
+            status[status_len++] = 'N';
+        else if (s->items[i].type == TERM) {
+            tmp_string = term_types[s->items[i].term_data.type];
+            strcpy(status + status_len, tmp_string);
+            status_len += (int) strlen(tmp_string);
+        }
 
-    for (int i = 0; i < status_len / 2; i++) {
-        tmp_char = status[i];
-        status[i] = status[status_len - i - 1];
-        status[status_len - i - 1] = tmp_char;
+        status[status_len++] = ' ';
     }
 
     LOG_DEBUG("Exprstack status: %s", status);
@@ -99,84 +97,55 @@ static non_term_t par_rule(exprstack_t *s);
 static non_term_t term_rule(exprstack_t *s);
 
 /**
- * Array of available rules
+ * Reductions by the topmost terminal (operator of the handle or the operand itself)
  */
-rule_fun_t rules[RULES_NUM] = {
-        strlen_rule, mul_rule, div_rule, int_div_rule, add_rule, sub_rule, concat_rule, lt_rule, leq_rule, gt_rule,
-        geq_rule, eq_rule, neq_rule, par_rule, term_rule
+static const struct reduction reductions[END + 1] = {
+        [STRLEN] = {HANDLE_TN, strlen_rule},
+        [MULTIPLICATION] = {HANDLE_NTN, mul_rule},
+        [DIVISION] = {HANDLE_NTN, div_rule},
+        [INT_DIVISION] = {HANDLE_NTN, int_div_rule},
+        [ADDITION] = {HANDLE_NTN, add_rule},
+        [SUBTRACTION] = {HANDLE_NTN, sub_rule},
+        [CONCAT] = {HANDLE_NTN, concat_rule},
+        [LT] = {HANDLE_NTN, lt_rule},
+        [LEQ] = {HANDLE_NTN, leq_rule},
+        [GT] = {HANDLE_NTN, gt_rule},
+        [GEQ] = {HANDLE_NTN, geq_rule},
+        [EQ] = {HANDLE_NTN, eq_rule},
+        [NEQ] = {HANDLE_NTN, neq_rule},
+        [RIGHT_PAR] = {HANDLE_TNT, par_rule},
+        [INTEGER] = {HANDLE_T, term_rule},
+        [NUMBER] = {HANDLE_T, term_rule},
+        [STRING] = {HANDLE_T, term_rule},
+        [IDENTIFIER] = {HANDLE_T, term_rule},
+        [KEYWORD] = {HANDLE_T, term_rule}
 };
 
 /**
- * Precedence table for controlling bottom-to-top syntactic analysis
- */
-enum expr_parser_operations precedence_table[17][17] = {
-        {R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_PSH, R_SHT, R_NON},
-        {R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_NON, R_RDC, R_NON, R_RDC},
-        {R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_NON, R_RDC, R_NON, R_RDC},
-        {R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_SHT, R_NON},
-};
-
-/**
- * Header (both row and column) of precedence table
+ * Returns column of precedence table for the token
+ *
+ * @param token Token on the stack or on the input
+ * @return Column of the token (PC_NONE for tokens, which can't be in expression)
  */
-enum token_type precedence_tab_header[PREC_TAB_HEADER_SIZE] = {
-        STRLEN, MULTIPLICATION, DIVISION, INT_DIVISION, ADDITION, SUBTRACTION, CONCAT, LT, LEQ, GT, GEQ, EQ, NEQ,
-        LEFT_PAR, RIGHT_PAR /* , TERM */, END
-};
-
-static int get_table_header_index(token_t token)
+static enum prec_columns get_prec_column(token_t token)
 {
-    enum token_type type = token.type;
-    int index = -1;
-
-    if (type == INTEGER || type == NUMBER || type == STRING || type == IDENTIFIER
-        || (type == KEYWORD && *token.keyword == KW_NIL))
-        return PREC_TAB_TERM_POS;
+    // The only keyword, which is a value
+    if (token.type == KEYWORD && *token.keyword != KW_NIL)
+        return PC_NONE;
 
-    for (int i = 0; i < PREC_TAB_HEADER_SIZE; i++) {
-        if (precedence_tab_header[i] == token.type) {
-            index = i;
-            break;
-        }
-    }
-
-    if (index != -1 && type != END)
-        return index;
-    if (index != -1 && type == END)
-        // One position is reserved for term, that cannot be there explicitly
-        return index + 1;
-    else
-        return -1;
+    return prec_columns[token.type];
 }
 
-static enum expr_parser_operations *table_lookup(token_t on_stack, token_t input)
+static enum expr_parser_operations table_lookup(token_t on_stack, token_t input)
 {
-    int row = get_table_header_index(on_stack);
-    int col = get_table_header_index(input);
-    token_t term_token = {.type = IDENTIFIER};
+    enum prec_columns row = get_prec_column(on_stack);
 
     // We must end with expression processing, when there is terminal on the stack and identifier on the input,
     // because assignment follows, and current token actually isn't for the expression parser
-    if (row == get_table_header_index(term_token) && input.type == IDENTIFIER)
-        return NULL;
+    if (row == PC_TERM && input.type == IDENTIFIER)
+        return R_END;
 
-    if (row == -1 || col == -1)
-        return NULL;
-    else
-        return &precedence_table[row][col];
+    return precedence_table[row][get_prec_column(input)];
 }
 
 static bool try_implicit_conversion(non_term_t *first_op, non_term_t *second_op)
@@ -225,9 +194,6 @@ static non_term_t strlen_rule(exprstack_t *s)
     // Data of operand
     non_term_t *operand;
 
-    if (!exprstack_check_top(s, "TN", strlen_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> #N");
 
     // Semantic checks
@@ -254,9 +220,6 @@ static non_term_t mul_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", mul_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N*N");
 
     // Semantic checks
@@ -292,9 +255,6 @@ static non_term_t div_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", div_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N/N");
 
     // Semantic checks
@@ -341,9 +301,6 @@ static non_term_t int_div_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", int_div_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N//N");
 
     // Semantic checks
@@ -378,9 +335,6 @@ static non_term_t add_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", add_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N+N");
 
     // Semantic checks
@@ -416,9 +370,6 @@ static non_term_t sub_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", sub_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N-N");
 
     // Semantic checks
@@ -454,9 +405,6 @@ static non_term_t concat_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", concat_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N..N");
 
     // Semantic checks
@@ -486,9 +434,6 @@ static non_term_t lt_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", lt_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N<N");
 
     // Semantic checks
@@ -517,9 +462,6 @@ static non_term_t leq_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", leq_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N<=N");
 
     // Semantic checks
@@ -548,9 +490,6 @@ static non_term_t gt_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", gt_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N>N");
 
     // Semantic checks
@@ -579,9 +518,6 @@ static non_term_t geq_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", geq_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N>=N");
 
     // Semantic checks
@@ -610,9 +546,6 @@ static non_term_t eq_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", eq_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N==N");
 
     // Semantic checks
@@ -639,9 +572,6 @@ static non_term_t neq_rule(exprstack_t *s)
     non_term_t *first_op;
     non_term_t *second_op;
 
-    if (!exprstack_check_top(s, "NTN", neq_term))
-        return result_non_term;
-
     LOG_DEBUG_M("Used rule: N --> N~=N");
 
     // Semantic checks
@@ -685,60 +615,59 @@ static non_term_t par_rule(exprstack_t *s)
 
 static non_term_t term_rule(exprstack_t *s)
 {
-    token_t int_term = {.type = INTEGER};
-    token_t num_term = {.type = NUMBER};
-    token_t str_term = {.type = STRING};
-    token_t id_term = {.type = IDENTIFIER};
-    keyword_t nil_kw = KW_NIL;
-    token_t nil_term = {.type = KEYWORD, .keyword = &nil_kw};
     non_term_t result_non_term = {.type = N_ERR};
     identifier_t identifier;
     token_t *top_term;
 
     // Get terminal's token from the top of the exprstack
     top_term = exprstack_top_term(s);
-    if (!top_term)
-        // There is no terminal at the top, so no term rule will pass
-        return result_non_term;
 
     // Literals and identifiers inherits data from token
     result_non_term.data = *top_term;
 
-    if (exprstack_check_top(s, "T", int_term)) {
-        LOG_DEBUG_M("Used rule: N <-- T (T = integer)");
-        result_non_term.data.type = INTEGER;
-    } else if (exprstack_check_top(s, "T", num_term)) {
-        LOG_DEBUG_M("Used rule: N <-- T (T = number)");
-        result_non_term.data.type = NUMBER;
-    } else if (exprstack_check_top(s, "T", str_term)) {
-        LOG_DEBUG_M("Used rule: N <-- T (T = string)");
-        result_non_term.data.type = STRING;
-    } else if (exprstack_check_top(s, "T", id_term)) {
-        LOG_DEBUG_M("Used rule: N <-- T (T = identifier)");
-
-        // Simplify type of output token
-        // We won't need all information about this term in other rules
-        identifier = *top_term->identifier;
-        switch (identifier.var.type) {
-            case VAR_INTEGER:
-                result_non_term.data.type = INTEGER;
-                break;
-            case VAR_NUMBER:
-                result_non_term.data.type = NUMBER;
-                break;
-            case VAR_STRING:
-                result_non_term.data.type = STRING;
-                break;
-            default:
-                result_non_term.type = N_ERR;
-                result_non_term.data.type = END;
-                break;
-        }
-    } else if (exprstack_check_top(s, "T", nil_term)) {
-        LOG_DEBUG_M("Used rule: N <-- T (T = nil)");
-        result_non_term.data.type = NIL;
-    } else
-        return result_non_term;
+    switch (top_term->type) {
+        case INTEGER:
+            LOG_DEBUG_M("Used rule: N <-- T (T = integer)");
+            break;
+        case NUMBER:
+            LOG_DEBUG_M("Used rule: N <-- T (T = number)");
+            break;
+        case STRING:
+            LOG_DEBUG_M("Used rule: N <-- T (T = string)");
+            break;
+        case IDENTIFIER:
+            LOG_DEBUG_M("Used rule: N <-- T (T = identifier)");
+
+            // Simplify type of output token
+            // We won't need all information about this term in other rules
+            identifier = *top_term->identifier;
+            switch (identifier.var.type) {
+                case VAR_INTEGER:
+                    result_non_term.data.type = INTEGER;
+                    break;
+                case VAR_NUMBER:
+                    result_non_term.data.type = NUMBER;
+                    break;
+                case VAR_STRING:
+                    result_non_term.data.type = STRING;
+                    break;
+                default:
+                    result_non_term.type = N_ERR;
+                    result_non_term.data.type = END;
+                    break;
+            }
+            break;
+        case KEYWORD:
+            // The only keyword, which is a value
+            if (*top_term->keyword != KW_NIL)
+                return result_non_term;
+
+            LOG_DEBUG_M("Used rule: N <-- T (T = nil)");
+            result_non_term.data.type = NIL;
+            break;
+        default:
+            return result_non_term;
+    }
 
     // We always reduce simple term
     result_non_term.type = N_VAL;
@@ -751,22 +680,13 @@ static non_term_t term_rule(exprstack_t *s)
 
 bool is_valid_variable(context_t *ctx, token_t *token)
 {
-    symtable_t *symtable;
-    identifier_t *tmp_id;
-
-    // Go through all tables of symbols and try to find checked identifier with type (declared variable)
-    symstack_most_local(ctx->symstack);
-    while (symstack_is_active(ctx->symstack)) {
-        symtable = symstack_get(ctx->symstack);
-        tmp_id = symtable_find(symtable, token->identifier->name);
-
-        if (tmp_id && tmp_id->type == VARIABLE) {
-            // It's a valid variable, so we are done here
-            token->identifier = tmp_id;
-            return true;
-        }
+    // Try to find checked identifier with type (declared variable) from the most-local scope
+    identifier_t *tmp_id = symstack_find_variable(ctx->symstack, token->identifier->atom);
 
-        symstack_next(ctx->symstack);
+    if (tmp_id) {
+        // It's a valid variable, so we are done here
+        token->identifier = tmp_id;
+        return true;
     }
 
     return false;
@@ -774,46 +694,45 @@ bool is_valid_variable(context_t *ctx, token_t *token)
 
 enum variable_type expr_parser_start(context_t *context)
 {
-    exprstack_t *exprstack = exprstack_create();
+    exprstack_t *exprstack = context->exprstack;
     token_t end_token = {.type = END};
     token_t input_token;
     token_t *stack_token;
-    enum expr_parser_operations *operation;
-    rule_fun_t rule;
+    enum expr_parser_operations operation;
+    const struct reduction *reduction;
     non_term_t rule_exec_result = {.type = N_ERR};
     bool done = false;
 
-    if (!exprstack)
-        exit(EINTERNAL);
+    // Stack is shared by all expressions, the previous one could leave its result there
+    exprstack_clear(exprstack);
+
+    // Pooled string literals mustn't be freed with exprstack's items
+    exprstack->owns_strings = !context->literals;
 
     LOG_DEBUG_M("Starting expression parser...");
 
     exprstack_push_term(exprstack, end_token);
     print_exprstack(exprstack);
 
-    input_token = get_next_token(context);
+    // Tokens are only peeked, so the one behind the expression stays in the scanner for the main parser
+    input_token = peek_token(context, 0);
     LOG_DEBUG("Loaded new token of type: %s", token_types[input_token.type]);
     while (!done || !exprstack_is_correctly_empty(exprstack)) {
         stack_token = exprstack_top_term(exprstack);
         LOG_DEBUG("Current term on the top of exprstack: %s", token_types[stack_token->type]);
         operation = table_lookup(*stack_token, input_token);
-        if (!operation) {
-            // Return token to the scanner (it will be needed in the main parser)
-            unget_token(input_token);
-            LOG_DEBUG_M("Putting back read token to the scanner...");
 
-            // Next tokens will be only "fake" END ones
-            LOG_DEBUG_M("Unknown token detected, ending with parsing loaded expression...");
-            done = true;
+        switch (operation) {
+            case R_END:
+                // Next tokens will be only "fake" END ones
+                LOG_DEBUG_M("Unknown token detected, ending with parsing loaded expression...");
+                done = true;
 
-            // Set "fake" END token, which is needed for correct finishing of expression
-            // syntactic analysis
-            input_token = end_token;
-            LOG_DEBUG_M("Loaded \"fake\" END token");
-            continue;
-        }
-
-        switch (*operation) {
+                // Set "fake" END token, which is needed for correct finishing of expression
+                // syntactic analysis
+                input_token = end_token;
+                LOG_DEBUG_M("Loaded \"fake\" END token");
+                continue;
             case R_PSH:
                 LOG_DEBUG_M("Selected operation (from precedence table): PUSH");
                 exprstack_push_term(exprstack, input_token);
@@ -834,14 +753,13 @@ enum variable_type expr_parser_start(context_t *context)
                 break;
             case R_RDC:
                 LOG_DEBUG_M("Selected operation (from precedence table): REDUCE");
-                for (int i = 0; i < RULES_NUM; i++) {
-                    rule = rules[i];
 
-                    rule_exec_result = rule(exprstack);
-                    if (rule_exec_result.type != N_ERR) {
-                        break;
-                    }
-                }
+                // The topmost terminal selects the only rule, which can be applied
+                reduction = &reductions[stack_token->type];
+                if (reduction->rule && exprstack_handle_shape(exprstack) == reduction->shape)
+                    rule_exec_result = reduction->rule(exprstack);
+                else
+                    rule_exec_result.type = N_ERR;
 
                 if (rule_exec_result.type != N_ERR) {
                     exprstack_pop_to_stop(exprstack);
@@ -863,9 +781,10 @@ enum variable_type expr_parser_start(context_t *context)
                 exit(ESYNTAX);
         }
 
-        // Move to the next input_token
+        // Move to the next input_token (the current one has been pushed to exprstack)
         if (!done) {
-            input_token = get_next_token(context);
+            get_next_token(context);
+            input_token = peek_token(context, 0);
             LOG_DEBUG("Loaded new token of type: %s", token_types[input_token.type]);
         } else {
             // At the end we need to generate "fake" END tokens,
@@ -878,9 +797,6 @@ enum variable_type expr_parser_start(context_t *context)
 
     LOG_DEBUG_M("Switching back to top-to-bottom syntactic analysis...");
 
-    // Clean up jobs
-    exprstack_destroy(exprstack);
-
     // Return type of the expression result
     if (rule_exec_result.data.type == INTEGER)
         return VAR_INTEGER;
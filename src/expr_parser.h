@@ -16,19 +16,6 @@
 #include "exprstack.h"
 #include "scanner.h"
 
-/**
- * Size precedence table header (number of column/rows in there)
- */
-#define PREC_TAB_HEADER_SIZE 17
-/**
- * Position of TERM item in precedence table header
- */
-#define PREC_TAB_TERM_POS 15
-/**
- * Number of rules in this static analysis
- */
-#define RULES_NUM 15
-
 /**
  * Checks if the operand is numeric
  */
@@ -57,17 +44,32 @@
  *      <li><code>R_PSH</code> (\=) - special case of shift (only push input to the stack)</li>
  *      <li><code>R_RDC</code> (\>) - reduce items on the stack with non-terminal</li>
  *      <li><code>R_NON</code> (empty) - forbidden combination</li>
+ *      <li><code>R_END</code> - token on the input isn't a part of the expression</li>
  * </ul>
  */
 enum expr_parser_operations {
-    R_SHT, R_PSH, R_RDC, R_NON
+    R_SHT, R_PSH, R_RDC, R_NON, R_END
 };
 
 /**
  * Function for applying a rule when it's on exprstack
+ *
+ * It's called only when the handle on exprstack has the shape of the rule,
+ * and its topmost terminal is the rule's one (see struct reduction).
  */
 typedef non_term_t (*rule_fun_t)(exprstack_t *);
 
+/**
+ * Reduction selected by the topmost terminal of exprstack
+ *
+ * shape  shape of the handle reduced by the rule (see exprstack_handle_shape())
+ * rule   function applying the rule
+ */
+struct reduction {
+    enum exprstack_handle_shapes shape;
+    rule_fun_t rule;
+};
+
 /**
  * Checks if identifier in the provided token is a variable
  *
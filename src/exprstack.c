@@ -17,18 +17,28 @@
 #include <string.h>
 #include <assert.h>
 
+/**
+ * Makes space for a new item on the top of the stack
+ *
+ * @param s Expressions stack
+ * @return Pointer to the new (uninitialized) item or NULL if error occurred
+ */
 static struct exprstack_item *create_item(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *new_item = malloc(sizeof(struct exprstack_item));
-    if (!new_item)
-        return NULL;
+    struct exprstack_item *items;
 
-    new_item->prev = s->top;
-    s->top = new_item;
+    if (s->count == s->capacity) {
+        items = realloc(s->items, 2 * s->capacity * sizeof(struct exprstack_item));
+        if (!items)
+            return NULL;
 
-    return new_item;
+        s->items = items;
+        s->capacity *= 2;
+    }
+
+    return &s->items[s->count++];
 }
 
 static bool token_equal(token_t first, token_t second)
@@ -48,8 +58,19 @@ exprstack_t *exprstack_create(void)
     if (!s)
         return NULL;
 
-    s->top = NULL;
-    s->active = NULL;
+    s->items = malloc(EXPRSTACK_INITIAL_CAPACITY * sizeof(struct exprstack_item));
+    s->stops = malloc(EXPRSTACK_INITIAL_STOPS * sizeof(size_t));
+    if (!s->items || !s->stops) {
+        free(s->items);
+        free(s->stops);
+        free(s);
+        return NULL;
+    }
+
+    s->capacity = EXPRSTACK_INITIAL_CAPACITY;
+    s->stop_capacity = EXPRSTACK_INITIAL_STOPS;
+    s->owns_strings = true;
+    exprstack_clear(s);
 
     return s;
 }
@@ -64,6 +85,7 @@ int exprstack_push_term(exprstack_t *s, token_t term)
 
     new_item->type = TERM;
     new_item->term_data = term;
+    s->top_term = s->count - 1;
 
     return 0;
 }
@@ -86,33 +108,30 @@ int exprstack_add_stop_after_top_term(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *term_item = s->top;
-    struct exprstack_item *next_item = NULL;
-    struct exprstack_item *new_item;
+    size_t position;
+    size_t *stops;
+    size_t i;
 
-    // Stack is empty
-    if (!term_item)
+    // There is no terminal (stack is empty)
+    if (s->top_term == EXPRSTACK_NO_ITEM)
         return -1;
 
-    while (term_item->type != TERM) {
-        next_item = term_item;
-        term_item = term_item->prev;
-    }
+    if (s->stop_count == s->stop_capacity) {
+        stops = realloc(s->stops, 2 * s->stop_capacity * sizeof(size_t));
+        if (!stops)
+            return -ENOMEM;
 
-    // Create a new term_item
-    new_item = malloc(sizeof(struct exprstack_item));
-    if (!new_item)
-        return -ENOMEM;
+        s->stops = stops;
+        s->stop_capacity *= 2;
+    }
 
-    // Setup new term_item
-    new_item->type = STOP;
-    new_item->prev = term_item;
+    // Stop goes right above the terminal, so it can be below stops of non-terminals above it
+    position = s->top_term + 1;
+    for (i = s->stop_count; i > 0 && s->stops[i - 1] >= position; i--)
+        s->stops[i] = s->stops[i - 1];
 
-    // Add a new term_item into stack
-    if (!next_item)
-        s->top = new_item;
-    else
-        next_item->prev = new_item;
+    s->stops[i] = position;
+    s->stop_count++;
 
     return 0;
 }
@@ -121,95 +140,76 @@ void exprstack_pop_to_stop(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *item = s->top;
-    struct exprstack_item *tmp_item;
-    enum exprstack_item_types type;
+    // Without stop the whole stack is popped
+    size_t bottom = s->stop_count > 0 ? s->stops[--s->stop_count] : 0;
 
-    // Empty stack
-    if (!item)
-        return;
+    if (s->owns_strings) {
+        for (size_t i = bottom; i < s->count; i++) {
+            if (s->items[i].type == TERM && s->items[i].term_data.type == STRING)
+                free(s->items[i].term_data.string);
+        }
+    }
 
-    do {
-        // Back up type of item to be deleted (we're looking for a STOP)
-        type = item->type;
-        tmp_item = item->prev;
+    s->count = bottom;
 
-        if (item->type == TERM && item->term_data.type == STRING)
-            free(item->term_data.string);
-        free(item);
-        item = tmp_item;
-    } while (item && type != STOP);
+    // Only the topmost terminal could be popped, so the cache has to be updated
+    if (s->top_term == EXPRSTACK_NO_ITEM || s->top_term < bottom)
+        return;
 
-    s->top = item ? item : NULL;
+    s->top_term = EXPRSTACK_NO_ITEM;
+    for (size_t i = bottom; i > 0; i--) {
+        if (s->items[i - 1].type == TERM) {
+            s->top_term = i - 1;
+            break;
+        }
+    }
 }
 
 token_t *exprstack_top_term(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *item = s->top;
-
-    // Empty stack
-    if (!item)
+    if (s->top_term == EXPRSTACK_NO_ITEM)
         return NULL;
 
-    while (item->type != TERM && item->prev)
-        item = item->prev;
-
-    if (item->type != TERM)
-        return NULL;
-    else
-        return &item->term_data;
+    return &s->items[s->top_term].term_data;
 }
 
-non_term_t *exprstack_top_non_term(exprstack_t *s)
+/**
+ * Finds the nearest non-terminal below the position and selects it
+ *
+ * @param s Expressions stack
+ * @param position Number of items to search in (from the bottom)
+ * @return Pointer to data of the found non-terminal or NULL if there is no non-terminal
+ */
+static non_term_t *select_non_term(exprstack_t *s, size_t position)
 {
-    assert(s);
-
-    struct exprstack_item *item = s->top;
+    for (size_t i = position; i > 0; i--) {
+        if (s->items[i - 1].type == NON_TERM) {
+            // Set activity to the found item
+            s->active = i - 1;
 
-    // Empty stack
-    if (!item)
-        return NULL;
+            return &s->items[i - 1].non_term_data;
+        }
+    }
 
-    while (item->type != NON_TERM && item->prev)
-        item = item->prev;
+    return NULL;
+}
 
-    if (item->type != NON_TERM)
-        return NULL;
-    else {
-        // Set activity to the found item
-        s->active = item;
+non_term_t *exprstack_top_non_term(exprstack_t *s)
+{
+    assert(s);
 
-        return &item->non_term_data;
-    }
+    return select_non_term(s, s->count);
 }
 
 non_term_t *exprstack_next_non_term(exprstack_t *s)
 {
     assert(s);
-    assert(s->active);
-
-    struct exprstack_item *item = s->active;
-
-    // There is only one (currently active) non-term
-    if (!item->prev)
-        return NULL;
-    else
-        // Move to the next item (active one can't be used)
-        item = item->prev;
+    assert(s->active != EXPRSTACK_NO_ITEM);
 
-    while (item->type != NON_TERM && item->prev)
-        item = item->prev;
-
-    if (item->type != NON_TERM)
-        return NULL;
-    else {
-        // Update activity to the found item
-        s->active = item;
-
-        return &item->non_term_data;
-    }
+    // Search continues below the active item (active one can't be used)
+    return select_non_term(s, s->active);
 }
 
 bool exprstack_check_top(exprstack_t *s, char *rule, ...)
@@ -217,89 +217,78 @@ bool exprstack_check_top(exprstack_t *s, char *rule, ...)
     assert(s);
     assert(rule);
 
-    int rule_length = (int) strlen(rule);
-    struct exprstack_item *item = s->top;
-    token_t stack_term;
+    size_t rule_length = strlen(rule);
+    struct exprstack_item *item;
     va_list terms;
-    token_t terms_list[rule_length];
+    bool matches = true;
 
-    // Function parameters needs to be reversed, because stack contains terminal reversed,
-    // so we need to prepare them into array that could be iterated in the reverse order
+    // Rule must lie right on the topmost stop, otherwise the rule on stack hasn't ended yet
+    if (s->stop_count == 0 || s->count < rule_length || s->stops[s->stop_count - 1] != s->count - rule_length)
+        return false;
+
+    // Items are stored from the bottom, so the rule and terminals can be checked in their order
+    item = &s->items[s->count - rule_length];
     va_start(terms, rule);
-    for (int i = 0; i < rule_length; i++) {
-        // At the places where are terminals in the rule will be their values,
-        // other places (where are non-terminals) are ignored
-        if (rule[i] == 'T')
-            terms_list[i] = va_arg(terms, token_t);
+    for (size_t i = 0; i < rule_length && matches; i++, item++) {
+        if (rule[i] == 'N')
+            matches = item->type == NON_TERM;
+        else if (rule[i] == 'T')
+            matches = item->type == TERM && token_equal(va_arg(terms, token_t), item->term_data);
+        else {
+            LOG_ERROR("Rule can contain only 'N' for non-terminal or 'T' for terminal. Found: %c", rule[i]);
+            exit(EINTERNAL);
+        }
     }
     va_end(terms);
 
-    // We need to go from the end of input rule, because stack contains it reversed
-    for (int i = rule_length - 1; i >= 0; i--) {
-        if (rule[i] == 'N') {
-            if (item->type != NON_TERM)
-                return false;
-        }
-        else if (rule[i] == 'T') {
-            if (item->type != TERM)
-                return false;
+    return matches;
+}
+
+unsigned exprstack_handle_shape(exprstack_t *s)
+{
+    assert(s);
 
-            stack_term = item->term_data;
+    unsigned shape = 1;
+    size_t bottom;
 
-            if (!token_equal(terms_list[i], stack_term))
-                return false;
-        } else {
-            LOG_ERROR("Rule can contain only 'N' for non-terminal or 'T' for terminal. Found: %c", rule[i]);
-            exit(EINTERNAL);
-        }
+    if (s->stop_count == 0)
+        return HANDLE_NONE;
 
-        // Go to previous item of the stack
-        if (!item->prev)
-            return false;
-        else
-            item = item->prev;
-    }
+    bottom = s->stops[s->stop_count - 1];
+    if (bottom == s->count || s->count - bottom > EXPRSTACK_MAX_HANDLE)
+        return HANDLE_NONE;
 
-    // There must be STOP now, otherwise the rule on stack hasn't ended yet
-    if (item->type != STOP)
-        return false;
+    for (size_t i = bottom; i < s->count; i++)
+        shape = shape << 1 | (s->items[i].type == TERM);
 
-    return true;
+    return shape;
 }
 
 bool exprstack_is_correctly_empty(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *top = s->top;
-    struct exprstack_item *bottom;
-
-    // Completely empty stack (not valid for us, see details in doc comment)
-    if (top)
-        bottom = top->prev;
-    else
-        return false;
-
     // State: $N
-    if (top->type == NON_TERM && bottom->type == TERM && bottom->term_data.type == END && bottom->prev == NULL)
-        return true;
-
-    return false;
+    return s->count == 2 && s->stop_count == 0
+           && s->items[0].type == TERM && s->items[0].term_data.type == END
+           && s->items[1].type == NON_TERM;
 }
 
-void exprstack_destroy(exprstack_t *s)
+void exprstack_clear(exprstack_t *s)
 {
     assert(s);
 
-    struct exprstack_item *item = s->top;
-    struct exprstack_item *tmp_item;
-
-    while (item) {
-        tmp_item = item->prev;
+    s->count = 0;
+    s->stop_count = 0;
+    s->top_term = EXPRSTACK_NO_ITEM;
+    s->active = EXPRSTACK_NO_ITEM;
+}
 
-        free(item);
-        item = tmp_item;
-    }
+void exprstack_destroy(exprstack_t *s)
+{
+    assert(s);
 
+    free(s->items);
+    free(s->stops);
     free(s);
 }
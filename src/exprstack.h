@@ -13,6 +13,10 @@
 
 #include "token.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 /**
  * Available types of exprstack item
  */
@@ -48,9 +52,9 @@ struct non_term_data {
  * Item of expression stack
  *
  * @details
- * It can contain non-terminal (it's general in bottom-to-top analysis),
- * stop (\<) and terminal (stored in token). Items are linked from top
- * to bottom of the stack, so every item has a link to the previous one.
+ * It can contain non-terminal (it's general in bottom-to-top analysis)
+ * or terminal (stored in token). Stops (\<) aren't items, they're stored
+ * as positions in the stack (see struct exprstack).
  */
 struct exprstack_item {
     enum exprstack_item_types type;
@@ -58,15 +62,68 @@ struct exprstack_item {
         token_t term_data;
         struct non_term_data non_term_data;
     };
-    struct exprstack_item *prev;
 };
 
+/**
+ * Shapes of handles (items above the topmost stop)
+ *
+ * @details
+ * Shape is a leading one bit followed by one bit for every item of the handle
+ * from the bottom (1 for terminal, 0 for non-terminal), e.g. NTN is 0b1010.
+ *
+ * @see exprstack_handle_shape()
+ */
+enum exprstack_handle_shapes {
+    HANDLE_NONE = 0x0, HANDLE_T = 0x3, HANDLE_TN = 0x6, HANDLE_NTN = 0xA, HANDLE_TNT = 0xD
+};
+
+/**
+ * Maximal length of handle with a shape (see exprstack_handle_shape())
+ */
+#define EXPRSTACK_MAX_HANDLE 8
+
+/**
+ * Initial number of items the stack has space for
+ */
+#define EXPRSTACK_INITIAL_CAPACITY 32
+
+/**
+ * Initial number of stops the stack has space for
+ */
+#define EXPRSTACK_INITIAL_STOPS 16
+
+/**
+ * Index used when there is no such item in the stack
+ */
+#define EXPRSTACK_NO_ITEM SIZE_MAX
+
 /**
  * Structure for storing metadata of expression stack
+ *
+ * Items are stored in a growable array from bottom to top. Every stop is
+ * stored as the number of items below it, stops are sorted from the lowest one.
+ * Index of the topmost terminal is cached, so it's always available immediately.
+ * When owns_strings is set, strings of STRING terminals are freed with their items.
+ *
+ * items          array of items (bottom at index 0)
+ * count          number of items in the stack
+ * capacity       number of items the array has space for
+ * stops          positions of stops (number of items below the stop)
+ * stop_count     number of stops
+ * stop_capacity  number of stops the array has space for
+ * top_term       index of the topmost terminal or EXPRSTACK_NO_ITEM
+ * active         index of the non-terminal selected by exprstack_*_non_term()
  */
 struct exprstack {
-    struct exprstack_item *top;
-    struct exprstack_item *active;
+    struct exprstack_item *items;
+    size_t count;
+    size_t capacity;
+    size_t *stops;
+    size_t stop_count;
+    size_t stop_capacity;
+    size_t top_term;
+    size_t active;
+    bool owns_strings;
 };
 
 /**
@@ -110,7 +167,7 @@ int exprstack_push_non_term(exprstack_t *s, non_term_t data);
  * Adds a new stop after the nearest terminal from the top of the stack
  *
  * @param s Expressions stack to modify
- * @return 0 if success, negative value elsewhere
+ * @return 0 if success, negative value elsewhere (-1 if the stack contains no terminals)
  * @pre s != NULL
  */
 int exprstack_add_stop_after_top_term(exprstack_t *s);
@@ -187,6 +244,20 @@ non_term_t *exprstack_next_non_term(exprstack_t *s);
  */
 bool exprstack_check_top(exprstack_t *s, char *rule, ...);
 
+/**
+ * Returns shape of the handle (items between the topmost stop and the top of the stack)
+ *
+ * @details
+ * Shape of the handle doesn't depend on values of terminals, so it can be compared
+ * with shape of a rule without parsing the rule (unlike exprstack_check_top()).
+ *
+ * @param s Expressions stack
+ * @return Shape of the handle (see enum exprstack_handle_shapes) or HANDLE_NONE when there is no stop,
+ * or the handle is empty or longer than EXPRSTACK_MAX_HANDLE
+ * @pre s != NULL
+ */
+unsigned exprstack_handle_shape(exprstack_t *s);
+
 /**
  * Checks if the expressions stack is correctly "empty" (see details)
  *
@@ -200,6 +271,19 @@ bool exprstack_check_top(exprstack_t *s, char *rule, ...);
  */
 bool exprstack_is_correctly_empty(exprstack_t *s);
 
+/**
+ * Removes all items and stops from the expressions stack
+ *
+ * @details
+ * Allocated space is kept (it's the high-water mark of previous expressions),
+ * so the stack can be reused for the next expression without any allocation.
+ * Strings of terminals aren't freed (like in exprstack_destroy()).
+ *
+ * @param s Expressions stack to clear
+ * @pre s != NULL
+ */
+void exprstack_clear(exprstack_t *s);
+
 /**
  * Destroys an existing expressions stack
  *
@@ -0,0 +1,186 @@
+#!/bin/bash
+
+# Generates header file with expression parser's precedence table from its description
+# Usage: ./gen-precedence-table.sh ../design/precedence_table.txt >precedence_table.h
+# $1 - Path to precedence table description (see the file for format description)
+
+# Precedence table description
+TABLE_FILE=$1
+
+if [ ! -f "$TABLE_FILE" ]; then
+  echo "Usage: $0 <precedence table description file>" >&2
+  exit 1
+fi
+
+export LC_ALL=C
+
+# Prints generated file header (the output is the part of the repository, so it needs the same header as others)
+function print_file_header() {
+  cat <<'EOF'
+/**
+ * @file precedence_table.h
+ * Precedence table of expression parser
+ *
+ * GENERATED FILE, DON'T EDIT IT MANUALLY!
+ * Source: design/precedence_table.txt, generator: src/gen-precedence-table.sh
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _PRECEDENCE_TABLE_H_
+#define _PRECEDENCE_TABLE_H_
+
+#include "expr_parser.h"
+
+#include <stdint.h>
+
+EOF
+}
+
+# Parses table description and prints enum and tables
+function generate_tables() {
+  awk '
+    function fail(message) {
+      printf("%s:%d: %s\n", FILENAME, FNR, message) > "/dev/stderr"
+      failed = 1
+      exit 1
+    }
+
+    # Prints one row of the table (9 items per line, the row would be too long otherwise)
+    function print_row(name, comment, items, i, line) {
+      print "    [PC_" name "] = { // " comment
+      line = "       "
+      for (i = 0; i < column_count; i++) {
+        line = line " " items[i] ","
+        if (i % 9 == 8 || i == column_count - 1) {
+          print line
+          line = "       "
+        }
+      }
+      print "    },"
+    }
+
+    BEGIN {
+      operations["<"] = "R_SHT"; operations["="] = "R_PSH"
+      operations[">"] = "R_RDC"; operations["."] = "R_NON"
+
+      # Pseudo-column of tokens, which aren'"'"'t in the table
+      columns[0] = "NONE"; symbols[0] = ""; column_count = 1
+      row_count = 0
+    }
+
+    # Empty lines and comments
+    /^[ \t]*(#|$)/ { next }
+
+    # Column definition
+    $1 == "column" {
+      if (NF < 4)
+        fail("column without tokens")
+      if (row_count > 0)
+        fail("columns must be defined before rows")
+      if ($2 in column_index)
+        fail("duplicate column " $2)
+      if ($3 in symbol_index)
+        fail("duplicate symbol " $3)
+
+      columns[column_count] = $2
+      column_index[$2] = column_count
+      symbols[column_count] = $3
+      symbol_index[$3] = column_count
+
+      for (i = 4; i <= NF; i++) {
+        if ($i in token_column)
+          fail("token " $i " is already in column " columns[token_column[$i]])
+
+        tokens[token_count++] = $i
+        token_column[$i] = column_count
+      }
+
+      column_count++
+      next
+    }
+
+    # Row of the table
+    $1 == "row" {
+      if (!($2 in symbol_index))
+        fail("unknown symbol " $2)
+      if ($2 in row_cells)
+        fail("duplicate row " $2)
+      if (NF != column_count + 1)
+        fail("row must have " column_count - 1 " operations")
+
+      operation_list = ""
+      for (i = 3; i <= NF; i++) {
+        if (!($i in operations))
+          fail("unknown operation " $i)
+
+        operation_list = operation_list (i > 3 ? " " : "") operations[$i]
+      }
+      row_cells[$2] = operation_list
+      row_count++
+      next
+    }
+
+    {
+      fail("unknown definition " $1)
+    }
+
+    END {
+      if (failed)
+        exit 1
+
+      for (i = 1; i < column_count; i++) {
+        if (!(symbols[i] in row_cells)) {
+          printf("%s: missing row %s\n", FILENAME, symbols[i]) > "/dev/stderr"
+          exit 1
+        }
+      }
+
+      print "/**"
+      print " * Columns (and rows) of precedence table"
+      print " *"
+      print " * PC_NONE is a column of tokens, which can'"'"'t be in expression (their operation is always R_END)"
+      print " */"
+      print "enum prec_columns {"
+      for (i = 0; i < column_count; i++)
+        print "    PC_" columns[i] "," (symbols[i] != "" ? " // " symbols[i] : "")
+      print "    PC_COUNT"
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Map of token types to columns of precedence table (unlisted tokens are in PC_NONE)"
+      print " */"
+      print "static const uint8_t prec_columns[END + 1] = {"
+      for (i = 0; i < token_count; i++)
+        print "    [" tokens[i] "] = PC_" columns[token_column[tokens[i]]] ","
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Precedence table (token on the top of the stack x token on the input --> operation)"
+      print " */"
+      print "static const uint8_t precedence_table[PC_COUNT][PC_COUNT] = {"
+      for (i = 0; i < column_count; i++)
+        none_row[i] = "R_END"
+      print_row("NONE", "tokens out of expression", none_row)
+      for (i = 1; i < column_count; i++) {
+        split(row_cells[symbols[i]], cells, " ")
+        row[0] = "R_END"
+        for (j = 1; j < column_count; j++)
+          row[j] = cells[j]
+        print_row(columns[i], symbols[i], row)
+      }
+      print "};"
+    }
+  ' "$TABLE_FILE"
+}
+
+# Control space
+print_file_header
+generate_tables || exit 1
+echo ""
+echo "#endif //_PRECEDENCE_TABLE_H_"
@@ -0,0 +1,256 @@
+#!/bin/bash
+
+# Generates header file with scanner's transition table from FSM description
+# Usage: ./gen-scanner-fsm.sh ../design/scanner_fsm.txt >scanner_fsm.h
+# $1 - Path to FSM description (see the file for format description)
+
+# FSM description
+FSM_FILE=$1
+
+if [ ! -f "$FSM_FILE" ]; then
+  echo "Usage: $0 <FSM description file>" >&2
+  exit 1
+fi
+
+# Characters must be processed byte by byte (sprintf("%c") is used as a reverse of ord())
+export LC_ALL=C
+
+# Prints generated file header (the output is the part of the repository, so it needs the same header as others)
+function print_file_header() {
+  cat <<'EOF'
+/**
+ * @file scanner_fsm.h
+ * Transition table of scanner's finite state machine
+ *
+ * GENERATED FILE, DON'T EDIT IT MANUALLY!
+ * Source: design/scanner_fsm.txt, generator: src/gen-scanner-fsm.sh
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _SCANNER_FSM_H_
+#define _SCANNER_FSM_H_
+
+/**
+ * Packs the next state and the action into one transition table's item
+ */
+#define FSM_T(next, action) ((unsigned short) ((action) << 8 | (next)))
+/**
+ * Extracts the next state from the transition table's item
+ */
+#define FSM_NEXT(transition) ((transition) & 0xff)
+/**
+ * Extracts the action from the transition table's item
+ */
+#define FSM_ACTION(transition) ((transition) >> 8)
+
+EOF
+}
+
+# Parses FSM description and prints enums and tables
+function generate_tables() {
+  awk '
+    function fail(message) {
+      printf("%s:%d: %s\n", FILENAME, FNR, message) > "/dev/stderr"
+      failed = 1
+      exit 1
+    }
+
+    # Converts character from description (incl. escape sequences) to its ASCII code
+    function char_code(token) {
+      if (token in escapes)
+        return escapes[token]
+      if (length(token) != 1 || !(token in ord))
+        fail("invalid character \"" token "\"")
+
+      return ord[token]
+    }
+
+    # Assigns character class to one character
+    function set_class(code, class) {
+      if (code in char_class)
+        fail("character " code " is already in class " char_class[code])
+
+      char_class[code] = class
+    }
+
+    BEGIN {
+      for (i = 1; i < 256; i++)
+        ord[sprintf("%c", i)] = i
+      escapes["\\n"] = 10; escapes["\\t"] = 9; escapes["\\v"] = 11
+      escapes["\\f"] = 12; escapes["\\r"] = 13; escapes["\\s"] = 32; escapes["\\\\"] = 92
+
+      classes[0] = "OTHER"; class_index["OTHER"] = 0; class_count = 1
+      actions[0] = "NONE"; action_index["-"] = 0; action_count = 1
+      state_count = 0
+    }
+
+    # Empty lines and comments
+    /^[ \t]*(#|$)/ { next }
+
+    # Character class definition
+    $1 == "class" {
+      if (NF < 3)
+        fail("class without characters")
+      if ($2 in class_index)
+        fail("duplicate class " $2)
+
+      classes[class_count] = $2
+      class_index[$2] = class_count
+
+      for (i = 3; i <= NF; i++) {
+        if (length($i) == 3 && substr($i, 2, 1) == "-") {
+          from = char_code(substr($i, 1, 1))
+          to = char_code(substr($i, 3, 1))
+          for (code = from; code <= to; code++)
+            set_class(code, class_count)
+        } else
+          set_class(char_code($i), class_count)
+      }
+
+      class_count++
+      next
+    }
+
+    # Transition
+    {
+      if (NF != 4)
+        fail("transition must have 4 fields")
+
+      state = $1
+      if (!(state in state_index)) {
+        states[state_count] = state
+        state_index[state] = state_count++
+      }
+
+      if ($4 != "-" && !($4 in action_index)) {
+        actions[action_count] = $4
+        action_index[$4] = action_count++
+      }
+
+      used_next[$3] = FNR
+
+      n = split($2, listed, ",")
+      for (i = 1; i <= n; i++) {
+        if (listed[i] == "*") {
+          default_next[state] = $3
+          default_action[state] = $4
+          continue
+        }
+        if (!(listed[i] in class_index))
+          fail("unknown class " listed[i])
+        if ((state, listed[i]) in next_state)
+          fail("duplicate transition from " state " by " listed[i])
+
+        next_state[state, listed[i]] = $3
+        next_action[state, listed[i]] = $4
+      }
+    }
+
+    END {
+      if (failed)
+        exit 1
+
+      for (target in used_next) {
+        if (target != "ACCEPT" && target != "ERROR" && !(target in state_index)) {
+          printf("%s:%d: unknown state %s\n", FILENAME, used_next[target], target) > "/dev/stderr"
+          exit 1
+        }
+      }
+
+      print "/**"
+      print " * Finite state machine'"'"'s states"
+      print " *"
+      print " * S_ACCEPT and S_ERROR are pseudo-states (they don'"'"'t have rows in transition table)"
+      print " */"
+      print "enum fsm_states {"
+      for (i = 0; i < state_count; i++)
+        print "    " states[i] ","
+      print "    S_ACCEPT, S_ERROR"
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Actions done when transition is used"
+      print " */"
+      print "enum fsm_actions {"
+      for (i = 0; i < action_count; i++)
+        print "    A_" actions[i] (i < action_count - 1 ? "," : "")
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Classes of input characters (characters with the same transitions)"
+      print " */"
+      print "enum char_class {"
+      for (i = 0; i < class_count; i++)
+        print "    CC_" classes[i] ","
+      print "    CC_COUNT"
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Map of characters to their classes"
+      print " */"
+      print "static const unsigned char fsm_char_classes[256] = {"
+      for (code = 0; code < 256; code++) {
+        if (!(code in char_class))
+          continue
+
+        if (code > 32 && code < 127 && code != 92)
+          comment = " // " sprintf("%c", code)
+        else
+          comment = ""
+        printf("    [%d] = CC_%s,%s\n", code, classes[char_class[code]], comment)
+      }
+      print "};"
+      print ""
+
+      print "/**"
+      print " * Transition table (state x character class --> FSM_T(next state, action))"
+      print " */"
+      print "static const unsigned short fsm_transitions[S_ACCEPT][CC_COUNT] = {"
+      for (i = 0; i < state_count; i++) {
+        state = states[i]
+        print "    [" state "] = {"
+        for (j = 0; j < class_count; j++) {
+          class = classes[j]
+          if ((state, class) in next_state) {
+            target = next_state[state, class]
+            action = next_action[state, class]
+          } else if (state in default_next) {
+            target = default_next[state]
+            action = default_action[state]
+          } else {
+            target = "ERROR"
+            action = "-"
+          }
+
+          if (target == "ACCEPT" || target == "ERROR")
+            target = "S_" target
+          # Two items per line (the table would be too long otherwise)
+          item = sprintf("[CC_%s] = FSM_T(%s, A_%s),", class, target, actions[action_index[action]])
+          if (j % 2 == 0)
+            line = "        " item
+          else {
+            print line " " item
+            line = ""
+          }
+        }
+        if (line != "")
+          print line
+        print "    },"
+      }
+      print "};"
+    }
+  ' "$FSM_FILE"
+}
+
+# Control space
+print_file_header
+generate_tables || exit 1
+echo ""
+echo "#endif //_SCANNER_FSM_H_"
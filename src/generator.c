@@ -20,12 +20,13 @@
 
 static void print_function_signature(identifier_t *id)
 {
-    if (!id->fun.param) {
+    // Signature is known before the definition only if the function was declared
+    if (id->type != FUNCTION) {
         return;
     }
     printf("# %s(", id->name);
-    for (int i = 0; id->fun.param[i] != '\0'; i++)
-        printf("%s%c", i == 0 ? "" : ",", id->fun.param[i]);
+    for (unsigned i = 0; i < id->fun.param.len; i++)
+        printf("%s%c", i == 0 ? "" : ",", signature_type(id->fun.param, i));
     printf(")\n");
 }
 
@@ -303,11 +304,11 @@ void gen_fun_param(identifier_t *id)
 {
     // will be called for each encountered param
     // need to move value that was passed to us to it
-    printf("DEFVAR LF@%s_%lu_%lu\n",
+    printf("DEFVAR LF@%s_%u_%u\n",
             id->name,
             id->line,
             id->character);
-    printf("MOVE LF@%s_%lu_%lu LF@%%%u\n",
+    printf("MOVE LF@%s_%u_%u LF@%%%u\n",
             id->name,
             id->line,
             id->character,
@@ -330,7 +331,7 @@ void gen_call_param(token_t *token, bool conv_to_number)
     printf("DEFVAR TF@%%%u\n", call_param_cnt);
 
     if (token->type == IDENTIFIER) {
-        printf("MOVE TF@%%%u LF@%s_%lu_%lu\n",
+        printf("MOVE TF@%%%u LF@%s_%u_%u\n",
                 call_param_cnt,
                 token->identifier->name,
                 token->identifier->line,
@@ -384,7 +385,7 @@ void gen_returned_assign(symqueue_t *queue, bool conv_to_number)
                 return_assign_cnt,
                 return_assign_cnt);
 
-    printf("MOVE LF@%s_%lu_%lu TF@%%retval_%d\n",
+    printf("MOVE LF@%s_%u_%u TF@%%retval_%d\n",
             var->name,
             var->line,
             var->character,
@@ -399,7 +400,7 @@ void gen_var_dec(identifier_t *id, symqueue_t *main_queue, symqueue_t *cycle_que
 
     if (cycle_level == 0) {
         // We're out of cycle, DEFVAR can be generated here
-        printf("DEFVAR LF@%s_%lu_%lu\n",
+        printf("DEFVAR LF@%s_%u_%u\n",
                id->name,
                id->line,
                id->character);
@@ -422,13 +423,13 @@ void gen_var_dec_assign(symqueue_t *queue, bool value_on_stack)
     }
     if (value_on_stack) {
         // expr/call result is on stack
-        printf("POPS LF@%s_%lu_%lu\n",
+        printf("POPS LF@%s_%u_%u\n",
                 var->name,
                 var->line,
                 var->character);
     } else {
         // there is no expr result
-        printf("MOVE LF@%s_%lu_%lu nil@nil\n",
+        printf("MOVE LF@%s_%u_%u nil@nil\n",
                 var->name,
                 var->line,
                 var->character);
@@ -455,7 +456,7 @@ void gen_var_active_assign(symqueue_t *queue, bool value_on_stack)
         if (var->line == 0 && var->character == 0) {
             printf("POPS LF@%s\n", var->name);
         } else {
-            printf("POPS LF@%s_%lu_%lu\n",
+            printf("POPS LF@%s_%u_%u\n",
                     var->name,
                     var->line,
                     var->character);
@@ -485,14 +486,13 @@ void gen_fun_end(identifier_t *id, symqueue_t *cycle_queue)
 
     while (!symqueue_is_empty(cycle_queue)) {
         var = symqueue_pop(cycle_queue);
-        printf("DEFVAR LF@%s_%lu_%lu\n",
+        printf("DEFVAR LF@%s_%u_%u\n",
                var->name,
                var->line,
                var->character);
 
         // There is a deep copy of original identifier from table of symbols,
-        // so it needs to completely deallocate (it is used only for this purpose)
-        free(var->name);
+        // so it needs to be deallocated (it is used only for this purpose)
         free(var);
     }
 
@@ -507,7 +507,7 @@ void gen_fun_end(identifier_t *id, symqueue_t *cycle_queue)
 void gen_push_term(token_t *token)
 {
     if (token->type == IDENTIFIER) {
-        printf("PUSHS LF@%s_%lu_%lu\n",
+        printf("PUSHS LF@%s_%u_%u\n",
                 token->identifier->name,
                 token->identifier->line,
                 token->identifier->character);
@@ -719,7 +719,7 @@ void gen_write_identifier(identifier_t *id)
 {
     gen_create_frame();
     printf("DEFVAR TF@%%1\n");
-    printf("MOVE TF@%%1 LF@%s_%lu_%lu\n",
+    printf("MOVE TF@%%1 LF@%s_%u_%u\n",
             id->name,
             id->line,
             id->character);
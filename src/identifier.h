@@ -12,11 +12,12 @@
 #ifndef _IDENTIFIER_H_
 #define _IDENTIFIER_H_
 
+#include "interner.h"
+#include "signature.h"
+
 #include <stdbool.h>
+#include <stdint.h>
 
-enum variable_type {
-    VAR_INTEGER='i', VAR_NUMBER='n', VAR_STRING='s', VAR_BOOL='b'
-};
 enum identifier_type {
     VARIABLE=1, FUNCTION
 };
@@ -24,23 +25,32 @@ enum identifier_type {
 /**
  * Structure representing an identifier,
  * an element of symtable.
+ *
+ * Name is interned, so name == atom->name (it's there just for convenience).
+ * Identifiers created outside tables of symbols don't need to have atom.
+ *
+ * Identifier fits into one cache line (64 bytes): flags are single bits, flags
+ * of functions are beside the type (they'd need a padded word in the union)
+ * and signatures of functions are stored inline. Position of the first occurrence
+ * is part of names of variables in generated code, so it's stored in full range.
  */
 typedef struct identifier {
-    char *name;
-    unsigned long line;
-    unsigned long character;
+    const char *name;
+    const atom_t *atom;
+    uint32_t line;
+    uint32_t character;
     enum identifier_type type;
+    bool defined : 1; // function only
+    bool called : 1; // function only
     union {
         struct variable {
             char type;
-            int init;
-            int used;
+            bool init : 1;
+            bool used : 1;
         } var;
         struct function {
-            int defined;
-            bool called;
-            char *param; // "" -> takes void
-            char *retval; // "" -> returns void
+            signature_t param; // empty -> takes void
+            signature_t retval; // empty -> returns void
         } fun;
     };
 } identifier_t;
@@ -49,8 +59,8 @@ typedef struct identifier {
  * Create a deep copy of identifier
  *
  * @details
- * Deep copy means all points contained in the identifier structure will be newly allocated
- * and original values copied to the new allocated space. You need to deallocate this copy
+ * Signatures are stored inline, so the copy doesn't share any data with the original
+ * (except interned name, it's never modified). You need to deallocate this copy
  * just like the original identifier.
  *
  * @param original_id Original identifier to create copy from
@@ -0,0 +1,177 @@
+/**
+ * @file interner.c
+ * Identifier names' interner
+ *
+ * Atoms are stored in open-addressing table with linear probing, which is
+ * grown twice when it's half full.
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#include "interner.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Source: http://isthe.com/chongo/tech/comp/fnv/ (FNV-1a)
+#define OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+interner_t *interner_create(void)
+{
+    interner_t *interner = malloc(sizeof(interner_t));
+    if (!interner)
+        return NULL;
+
+    interner->slots = NULL;
+    interner->slot_count = 0;
+    interner->atom_count = 0;
+
+    return interner;
+}
+
+uint32_t interner_hash(const char *name, size_t len)
+{
+    uint32_t h = OFFSET_BASIS;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char) name[i];
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+/**
+ * Finds slot of the name (the one with its atom or the empty one, where it belongs)
+ *
+ * @param interner Interner to search in
+ * @param name Name to find
+ * @param len Length of the name
+ * @param hash Hash of the name
+ * @return Index of the slot
+ *
+ * @pre interner->slot_count > 0
+ */
+static size_t find_slot(const interner_t *interner, const char *name, size_t len, uint32_t hash)
+{
+    const atom_t **slots = interner->slots;
+    size_t mask = interner->slot_count - 1;
+    size_t i = hash & mask;
+
+    while (slots[i]) {
+        if (slots[i]->hash == hash && slots[i]->len == len && memcmp(slots[i]->name, name, len) == 0)
+            return i;
+
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+/**
+ * Makes the table bigger (or creates it)
+ *
+ * @param interner Interner to grow
+ * @return true if success otherwise false
+ */
+static bool grow_table(interner_t *interner)
+{
+    const atom_t **old_slots = interner->slots;
+    size_t old_count = interner->slot_count;
+    size_t new_count = old_count ? old_count * 2 : INTERNER_INITIAL_SLOTS;
+    size_t mask = new_count - 1;
+    const atom_t **slots;
+    size_t j;
+
+    slots = calloc(new_count, sizeof(atom_t *));
+    if (!slots)
+        return false;
+
+    // Move atoms to the new table (names are distinct, so only empty slot is needed)
+    for (size_t i = 0; i < old_count; i++) {
+        if (!old_slots[i])
+            continue;
+
+        j = old_slots[i]->hash & mask;
+        while (slots[j])
+            j = (j + 1) & mask;
+        slots[j] = old_slots[i];
+    }
+
+    free(old_slots);
+    interner->slots = slots;
+    interner->slot_count = new_count;
+
+    return true;
+}
+
+const atom_t *interner_intern(interner_t *interner, const char *name, size_t len)
+{
+    assert(interner);
+    assert(name || len == 0);
+
+    uint32_t hash = interner_hash(name, len);
+    atom_t *atom;
+    size_t i;
+
+    // Keep the table at most half full
+    if (2 * (interner->atom_count + 1) > interner->slot_count && !grow_table(interner))
+        return NULL;
+
+    i = find_slot(interner, name, len, hash);
+    if (interner->slots[i])
+        return interner->slots[i];
+
+    // The name is new
+    atom = malloc(sizeof(atom_t) + len + 1);
+    if (!atom)
+        return NULL;
+
+    atom->hash = hash;
+    atom->len = len;
+    if (len > 0)
+        memcpy(atom->name, name, len);
+    atom->name[len] = '\0';
+
+    interner->slots[i] = atom;
+    interner->atom_count++;
+
+    return atom;
+}
+
+const atom_t *interner_lookup(const interner_t *interner, const char *name, size_t len)
+{
+    assert(interner);
+    assert(name || len == 0);
+
+    if (interner->slot_count == 0)
+        return NULL;
+
+    return interner->slots[find_slot(interner, name, len, interner_hash(name, len))];
+}
+
+void interner_clear(interner_t *interner)
+{
+    assert(interner);
+
+    for (size_t i = 0; i < interner->slot_count; i++)
+        free((atom_t *) interner->slots[i]);
+
+    free(interner->slots);
+    interner->slots = NULL;
+    interner->slot_count = 0;
+    interner->atom_count = 0;
+}
+
+void interner_destroy(interner_t *interner)
+{
+    assert(interner);
+
+    interner_clear(interner);
+    free(interner);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file interner.h
+ * Header file of identifier names' interner
+ *
+ * Interner stores each distinct name only once (as an atom) together with its
+ * hash. Names can be compared by comparing pointers to their atoms, and tables
+ * of symbols don't need to hash them again. Atoms belong to the interner
+ * (one per compilation, see context_t) and they live until it's cleared or destroyed.
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _INTERNER_H_
+#define _INTERNER_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Initial number of slots in interner's table (must be a power of 2)
+ */
+#define INTERNER_INITIAL_SLOTS 256
+
+/**
+ * Interned name
+ *
+ * Content:
+ * <ul>
+ *      <li><code>hash</code> - FNV-1a hash of the name</li>
+ *      <li><code>len</code> - Length of the name</li>
+ *      <li><code>name</code> - Null-terminated name</li>
+ * </ul>
+ */
+typedef struct atom {
+    uint32_t hash;
+    size_t len;
+    char name[];
+} atom_t;
+
+/**
+ * Interner of names
+ *
+ * Atoms are stored in open-addressing table with linear probing.
+ *
+ * Content:
+ * <ul>
+ *      <li><code>slots</code> - Table of atoms (NULL is an empty slot)</li>
+ *      <li><code>slot_count</code> - Number of slots in the table (power of 2 or 0 before the first interning)</li>
+ *      <li><code>atom_count</code> - Number of stored atoms</li>
+ * </ul>
+ */
+typedef struct interner {
+    const atom_t **slots;
+    size_t slot_count;
+    size_t atom_count;
+} interner_t;
+
+/**
+ * Creates a new empty interner
+ *
+ * @return Pointer to the new interner or NULL if error occurred
+ */
+interner_t *interner_create(void);
+
+/**
+ * Computes FNV-1a hash of the name
+ *
+ * @param name Name to hash (doesn't need to be null-terminated)
+ * @param len Length of the name
+ * @return Hash of the name
+ */
+uint32_t interner_hash(const char *name, size_t len);
+
+/**
+ * Finds atom of the name or creates it if the name hasn't been interned yet
+ *
+ * @param interner Interner to use
+ * @param name Name to intern (doesn't need to be null-terminated)
+ * @param len Length of the name
+ * @return Atom of the name or NULL if error occurred
+ *
+ * @pre interner != NULL
+ * @pre name != NULL || len == 0
+ */
+const atom_t *interner_intern(interner_t *interner, const char *name, size_t len);
+
+/**
+ * Finds atom of the name without creating it
+ *
+ * @param interner Interner to search in
+ * @param name Name to find (doesn't need to be null-terminated)
+ * @param len Length of the name
+ * @return Atom of the name or NULL if the name hasn't been interned
+ *
+ * @pre interner != NULL
+ * @pre name != NULL || len == 0
+ */
+const atom_t *interner_lookup(const interner_t *interner, const char *name, size_t len);
+
+/**
+ * Releases all atoms of the interner
+ *
+ * Pointers to its atoms (and to their names) are invalid after the call.
+ *
+ * @param interner Interner to clear
+ *
+ * @pre interner != NULL
+ */
+void interner_clear(interner_t *interner);
+
+/**
+ * Destroys interner with all its atoms
+ *
+ * @param interner Interner to destroy
+ *
+ * @pre interner != NULL
+ */
+void interner_destroy(interner_t *interner);
+
+#endif //_INTERNER_H_
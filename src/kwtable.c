@@ -15,6 +15,51 @@
 #include <string.h>
 #include <assert.h>
 
+/**
+ * Makes an item of perfect hash table for keyword (the first and the last characters are needed for hash)
+ */
+#define KW_SLOT(name, first, last, keyword) \
+    [KWTABLE_HASH(sizeof(name) - 1, first, last)] = {name, sizeof(name) - 1, keyword}
+
+/**
+ * Slot of the keywords' perfect hash table
+ *
+ * Content:
+ * <ul>
+ *      <li><code>name</code> - Keyword in string form (NULL in empty slot)</li>
+ *      <li><code>len</code> - Length of the name (0 in empty slot)</li>
+ *      <li><code>keyword</code> - Keyword in integer-like form</li>
+ * </ul>
+ */
+struct kwtable_slot {
+    const char *name;
+    size_t len;
+    keyword_t keyword;
+};
+
+/**
+ * Perfect hash table of keywords (it's fixed at compile time)
+ */
+static const struct kwtable_slot kwtable_slots[KWTABLE_SLOTS] = {
+    KW_SLOT("do", 'd', 'o', KW_DO),
+    KW_SLOT("else", 'e', 'e', KW_ELSE),
+    KW_SLOT("end", 'e', 'd', KW_END),
+    KW_SLOT("function", 'f', 'n', KW_FUNCTION),
+    KW_SLOT("global", 'g', 'l', KW_GLOBAL),
+    KW_SLOT("if", 'i', 'f', KW_IF),
+    KW_SLOT("integer", 'i', 'r', KW_INTEGER),
+    KW_SLOT("local", 'l', 'l', KW_LOCAL),
+    KW_SLOT("nil", 'n', 'l', KW_NIL),
+    KW_SLOT("number", 'n', 'r', KW_NUMBER),
+    KW_SLOT("require", 'r', 'e', KW_REQUIRE),
+    KW_SLOT("return", 'r', 'n', KW_RETURN),
+    KW_SLOT("string", 's', 'g', KW_STRING),
+    KW_SLOT("then", 't', 'n', KW_THEN),
+    KW_SLOT("while", 'w', 'e', KW_WHILE),
+};
+
+#undef KW_SLOT
+
 kwtable_t *kwtable_create(void)
 {
     kwtable_t *table = malloc(sizeof(kwtable_t));
@@ -29,32 +74,25 @@ kwtable_t *kwtable_create(void)
 }
 
 keyword_t *kwtable_find(kwtable_t *table, char *keyword_name)
+{
+    return kwtable_find_n(table, keyword_name, strlen(keyword_name));
+}
+
+keyword_t *kwtable_find_n(kwtable_t *table, const char *keyword_name, size_t len)
 {
     assert(table);
 
-    // Set of allowed keywords in string form
-    char *keywords[NUMBER_OF_KEYWORDS] = {
-            "do", "else", "end", "function", "global", "if", "integer", "local", "nil",
-            "number", "require", "return", "string", "then", "while"
-    };
-
-    int left = 0, right = NUMBER_OF_KEYWORDS - 1, middle;
-    int compare_result;
-
-    do {
-        middle = (left + right) / 2;
-        compare_result = strcmp(keyword_name, keywords[middle]);
-
-        if (compare_result < 0)
-            right = middle - 1;
-        else if(compare_result > 0)
-            left = middle + 1;
-        else
-            return &((*table)[middle]);
-    }
-    while (right >= left);
+    const struct kwtable_slot *slot;
+
+    // Empty slots have zero length, so they can't match (there is no empty keyword)
+    if (len == 0)
+        return NULL;
+
+    slot = &kwtable_slots[KWTABLE_HASH(len, keyword_name[0], keyword_name[len - 1])];
+    if (slot->len != len || memcmp(slot->name, keyword_name, len) != 0)
+        return NULL;
 
-    return NULL;
+    return &((*table)[slot->keyword]);
 }
 
 void kwtable_destroy(kwtable_t *table)
@@ -11,12 +11,28 @@
 #ifndef _KWTABLE_H_
 #define _KWTABLE_H_
 
+#include <stdlib.h>
+
 /**
  * Keywords are predefined finite set, so we know its size
  * and can use it for defining static data structures, for example
  */
 #define NUMBER_OF_KEYWORDS 15
 
+/**
+ * Number of slots of the keywords' perfect hash table (must be a power of 2)
+ */
+#define KWTABLE_SLOTS 32
+
+/**
+ * Perfect hash function of keywords (every keyword has its own slot)
+ *
+ * It uses only length and the first and the last character, so it's cheap to compute
+ * and it can be used in constant expressions.
+ */
+#define KWTABLE_HASH(len, first, last) \
+        (((len) + 6 * (unsigned char) (first) + (unsigned char) (last)) & (KWTABLE_SLOTS - 1))
+
 /**
  * Keyword in integer-like form for simple comparing
  */
@@ -50,6 +66,20 @@ kwtable_t *kwtable_create(void);
  */
 keyword_t *kwtable_find(kwtable_t *table, char *keyword_name);
 
+/**
+ * Searches for a keyword with known length in the table
+ *
+ * Keyword is found by one probe to the perfect hash table and one memcmp().
+ *
+ * @param table Keywords table to use
+ * @param keyword_name Name of the keyword to search for (doesn't need to be null-terminated)
+ * @param len Length of the name
+ * @return Pointer to keyword if found otherwise NULL
+ *
+ * @pre table != NULL
+ */
+keyword_t *kwtable_find_n(kwtable_t *table, const char *keyword_name, size_t len);
+
 /**
  * Destroys keywords table
  *
@@ -15,54 +15,116 @@
 #include "parser.h"
 #include "symtable.h"
 #include "identifier.h"
+#include "source.h"
+#include "scanner.h"
+#include "strpool.h"
+#include "exprstack.h"
+#include "interner.h"
+#include "tokcache.h"
 #include "string.h"
 
-static void add_builtin_function(symtable_t *symtable, char *name, char *param, char *retval)
+/**
+ * Sets up scanner's token cache
+ *
+ * Tokens are read from the cache file if it belongs to the current source. Otherwise
+ * scanned tokens are collected to be saved by save_token_cache().
+ *
+ * @param scanner Scanner with loaded source
+ * @param interner Interner for names of cached identifiers
+ * @param path Path to the cache file
+ */
+static void setup_token_cache(scanner_t *scanner, interner_t *interner, const char *path)
 {
-    identifier_t *fun;
-    char *param_alloc;
-    char *retval_alloc;
+    FILE *file = fopen(path, "rb");
+
+    if (file) {
+        scanner->cache_reader = tokcache_reader_open(file, scanner->source, interner);
+        fclose(file);
+
+        if (scanner->cache_reader)
+            return;
+    }
 
-    param_alloc = malloc(strlen(param) + 1);
-    retval_alloc = malloc(strlen(retval) + 1);
-    if (!param_alloc || !retval_alloc)
+    scanner->cache_writer = tokcache_writer_create();
+    if (!scanner->cache_writer)
         exit(EINTERNAL);
+}
 
-    strcpy(param_alloc, param);
-    strcpy(retval_alloc, retval);
+/**
+ * Saves collected tokens into the cache file (if there are any)
+ *
+ * The file is written under temporary name and renamed at the end, so incomplete
+ * cache is never used. Cache is optional, so failure is only logged.
+ *
+ * @param scanner Scanner after the whole program was processed
+ * @param path Path to the cache file
+ */
+static void save_token_cache(scanner_t *scanner, const char *path)
+{
+    char *tmp_path;
+    FILE *file;
+    int ret = -1;
+
+    if (!scanner->cache_writer)
+        return;
+
+    tmp_path = malloc(strlen(path) + sizeof(".tmp"));
+    if (!tmp_path)
+        exit(EINTERNAL);
+    sprintf(tmp_path, "%s.tmp", path);
+
+    file = fopen(tmp_path, "wb");
+    if (file) {
+        ret = tokcache_writer_save(scanner->cache_writer, file, scanner->source);
+        if (fclose(file) != 0)
+            ret = -1;
+    }
 
-    fun = symtable_add(symtable, name);
-    fun->type = FUNCTION;
-    fun->line = 0;
-    fun->character = 0;
-    fun->fun.defined = true;
-    fun->fun.param = param_alloc;
-    fun->fun.retval = retval_alloc;
+    if (ret < 0 || rename(tmp_path, path) != 0) {
+        LOG_ERROR("Token cache %s can't be written", path);
+        remove(tmp_path);
+    }
+
+    free(tmp_path);
 }
 
-static void init_builtin_functions(symtable_t *symtable)
+#ifdef SYMTABLE_STATS
+/**
+ * Prints statistics of symbol machinery to stderr (it's called at exit, so failed compilations are included, too)
+ */
+static void print_symbol_stats(void)
 {
-    add_builtin_function(symtable, "reads", "", "s");
-    add_builtin_function(symtable, "readi", "", "i");
-    add_builtin_function(symtable, "readn", "", "n");
-    add_builtin_function(symtable, "write", "write", "");
-    add_builtin_function(symtable, "tointeger", "n", "i");
-    add_builtin_function(symtable, "substr", "snn", "s");
-    add_builtin_function(symtable, "ord", "si", "i");
-    add_builtin_function(symtable, "chr", "i", "s");
+    symtable_stats_print(stderr);
 }
+#endif
 
-int main()
+int main(int argc, char *argv[])
 {
     context_t ctx;
-    int ret;
+    const char *token_cache_path = NULL;
+
+    // The program is always read from stdin, options just change the way it's processed
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--token-cache") == 0 && i + 1 < argc) {
+            token_cache_path = argv[++i];
+        } else if (strcmp(argv[i], "--symbol-stats") == 0) {
+#ifdef SYMTABLE_STATS
+            atexit(print_symbol_stats);
+#else
+            fprintf(stderr, "Statistics of symbols aren't available (compile with -DSYMTABLE_STATS)\n");
+#endif
+        } else {
+            fprintf(stderr, "Usage: %s [--token-cache <file>] [--symbol-stats] <program\n", argv[0]);
+            exit(EINTERNAL);
+        }
+    }
 
-    symstack_t *symstack = symstack_create();
-    if (!symstack)
+    symtable_t *global_symtable = symtable_create_arena();
+    if (!global_symtable)
         exit(EINTERNAL);
 
-    symtable_t *global_symtable = symtable_create();
-    if (!global_symtable)
+    symstack_t *symstack = symstack_create(global_symtable);
+    if (!symstack)
         exit(EINTERNAL);
 
     kwtable_t *kwtable = kwtable_create();
@@ -73,14 +135,6 @@ int main()
     if (!string)
         exit(EINTERNAL);
 
-    string_t *param = string_create();
-    if (!param)
-        exit(EINTERNAL);
-
-    string_t *retval = string_create();
-    if (!retval)
-        exit(EINTERNAL);
-
     symqueue_t *main_symqueue = symqueue_create();
     if (!main_symqueue)
         exit(EINTERNAL);
@@ -89,41 +143,73 @@ int main()
     if (!cycle_symqueue)
         exit(EINTERNAL);
 
-    init_builtin_functions(global_symtable);
+    source_t *source = source_create(stdin);
+    if (!source)
+        exit(EINTERNAL);
+
+    scanner_t *scanner = scanner_create(source);
+    if (!scanner)
+        exit(EINTERNAL);
+
+    interner_t *interner = interner_create();
+    if (!interner)
+        exit(EINTERNAL);
+
+    if (token_cache_path)
+        setup_token_cache(scanner, interner, token_cache_path);
+
+    strpool_t *literals = strpool_create();
+    if (!literals)
+        exit(EINTERNAL);
 
-    ret = symstack_push(symstack, global_symtable);
-    if (ret < 0)
+    exprstack_t *exprstack = exprstack_create();
+    if (!exprstack)
+        exit(EINTERNAL);
+
+    signature_pool_t *signatures = signature_pool_create();
+    if (!signatures)
         exit(EINTERNAL);
 
     ctx.symstack = symstack;
     ctx.kwtable = kwtable;
     ctx.string = string;
-    ctx.param = param;
-    ctx.retval = retval;
+    ctx.param = (signature_t) SIGNATURE(0, 0);
+    ctx.retval = (signature_t) SIGNATURE(0, 0);
+    ctx.signatures = signatures;
     ctx.main_symqueue = main_symqueue;
     ctx.cycle_symqueue = cycle_symqueue;
+    ctx.scanner = scanner;
+    ctx.literals = literals;
+    ctx.interner = interner;
+    ctx.exprstack = exprstack;
 
     parser_start(&ctx);
 
-    // check global symtable is the last remaining
-    if (symstack_pop(symstack) != global_symtable) {
-        LOG_ERROR_M("Global symtable is NOT the only remaining one!");
-        while (symstack_pop(symstack)) {
-            LOG_ERROR_M("Popped remaining local symtable.");
+    if (token_cache_path)
+        save_token_cache(scanner, token_cache_path);
+
+    // check global scope is the last remaining
+    if (symstack_depth(symstack) != 0) {
+        LOG_ERROR_M("Global scope is NOT the only remaining one!");
+        while (symstack_pop_scope(symstack) == 0) {
+            LOG_ERROR_M("Left remaining local scope.");
         }
     }
 
-    string_destroy(retval);
-    string_destroy(param);
+    signature_pool_destroy(signatures);
+    exprstack_destroy(exprstack);
+    strpool_destroy(literals);
+    scanner_destroy(scanner);
     string_destroy(string);
     kwtable_destroy(kwtable);
-    symtable_destroy(global_symtable);
     symstack_destroy(symstack);
+    symtable_destroy(global_symtable);
     while (!symqueue_is_empty(main_symqueue))
         symqueue_pop(main_symqueue);
     symqueue_destroy(main_symqueue);
     while (!symqueue_is_empty(cycle_symqueue))
         symqueue_pop(cycle_symqueue);
     symqueue_destroy(cycle_symqueue);
+    interner_destroy(interner);
     return 0;
 }
@@ -14,7 +14,6 @@
 #define LOG_LEVEL ERROR
 #include "logger.h"
 #include "scanner.h"
-#include "string_factory.h"
 #include "symtable.h"
 #include "symstack.h"
 #include "token.h"
@@ -86,7 +85,7 @@ static void debug_identifier(identifier_t *id)
         return;
     if (id->type == FUNCTION) {
         LOG_DEBUG("name: '%s' param: '%s' retval: '%s' defined: %d",
-                id->name, id->fun.param, id->fun.retval, id->fun.defined);
+                id->name, SIGNATURE_STRING(id->fun.param), SIGNATURE_STRING(id->fun.retval), id->defined);
     } else if (id->type == VARIABLE) {
         LOG_DEBUG("name: '%s' type: '%c' init: '%d' used: %d",
                 id->name, id->var.type, id->var.init, id->var.used);
@@ -95,13 +94,35 @@ static void debug_identifier(identifier_t *id)
     }
 }
 
+/**
+ * Appends type to the signature (types of long signatures are stored in the context's pool)
+ */
+static void append_type(context_t *ctx, signature_t *signature, enum variable_type type)
+{
+    if (signature_append(ctx->signatures, signature, type) < 0) {
+        LOG_ERROR_M("Types of signature can't be stored");
+        exit(EINTERNAL);
+    }
+}
+
+/**
+ * Appends type of argument of the called function (saved_id)
+ *
+ * Arguments of function with variable number of parameters are not checked, so they are not collected.
+ */
+static void append_argument(context_t *ctx, enum variable_type type)
+{
+    if (!ctx->saved_id->fun.param.varargs)
+        append_type(ctx, &ctx->param, type);
+}
+
 static token_t term(token_t token, context_t *ctx)
 {
     LOG_DEBUG_M();
     debug_token(token);
     debug_identifier(ctx->saved_id);
-    int param_index;
     bool implicit_conv = false;
+    bool varargs = ctx->saved_id->fun.param.varargs;
     enum variable_type converted;
 
     if (token.type == IDENTIFIER) {
@@ -113,8 +134,7 @@ static token_t term(token_t token, context_t *ctx)
         converted = token.identifier->var.type;
 
         if (token.identifier->var.type == VAR_INTEGER) {
-            param_index = strlen(string_expose(ctx->param));
-            if (ctx->saved_id->fun.param[param_index] == VAR_NUMBER) {
+            if (signature_type(ctx->saved_id->fun.param, ctx->param.len) == VAR_NUMBER) {
                 LOG_DEBUG("will do implicit conv for variable '%s'",
                         token.identifier->name);
                 implicit_conv = true;
@@ -124,9 +144,9 @@ static token_t term(token_t token, context_t *ctx)
 
         LOG_DEBUG_M("id ok");
         debug_identifier(token.identifier);
-        string_appendc(ctx->param, converted);
+        append_argument(ctx, converted);
 
-        if (!strcmp(ctx->saved_id->fun.param, "write")) {
+        if (varargs) {
             gen_write_identifier(token.identifier);
         } else {
             gen_call_param(&token, implicit_conv);
@@ -139,17 +159,16 @@ static token_t term(token_t token, context_t *ctx)
     } else if (token.type == INTEGER) {
         LOG_DEBUG_M("TYPE integer ok");
 
-        param_index = strlen(string_expose(ctx->param));
-        if (ctx->saved_id->fun.param[param_index] == VAR_NUMBER) {
+        if (signature_type(ctx->saved_id->fun.param, ctx->param.len) == VAR_NUMBER) {
                 LOG_DEBUG("will do implicit conv for integer term '%d'",
                         token.integer);
                 implicit_conv = true;
-                string_appendc(ctx->param, VAR_NUMBER);
+                append_argument(ctx, VAR_NUMBER);
         } else {
-            string_appendc(ctx->param, VAR_INTEGER);
+            append_argument(ctx, VAR_INTEGER);
         }
 
-        if (!strcmp(ctx->saved_id->fun.param, "write")) {
+        if (varargs) {
             gen_write_integer(token.integer);
         } else {
             gen_call_param(&token, implicit_conv);
@@ -160,9 +179,9 @@ static token_t term(token_t token, context_t *ctx)
 
     } else if (token.type == NUMBER) {
         LOG_DEBUG_M("TYPE number ok");
-        string_appendc(ctx->param, VAR_NUMBER);
+        append_argument(ctx, VAR_NUMBER);
 
-        if (!strcmp(ctx->saved_id->fun.param, "write")) {
+        if (varargs) {
             gen_write_number(token.number);
         } else {
             gen_call_param(&token, false);
@@ -173,24 +192,25 @@ static token_t term(token_t token, context_t *ctx)
 
     } else if (token.type == STRING) {
         LOG_DEBUG_M("TYPE string ok");
-        string_appendc(ctx->param, VAR_STRING);
+        append_argument(ctx, VAR_STRING);
 
-        if (!strcmp(ctx->saved_id->fun.param, "write")) {
+        if (varargs) {
             gen_write_string(token.string);
         } else {
             gen_call_param(&token, false);
         }
         // is string not used after this?
         // code using it is generated, so I think
-        // we can free it
-        free(token.string);
+        // we can free it (pooled literals are released at the end of compilation)
+        if (!ctx->literals)
+            free(token.string);
 
         token = get_next_token(ctx);
         return token;
 
     } else if (token.type == KEYWORD) {
         if (*token.keyword == KW_NIL) {
-            if (!strcmp(ctx->saved_id->fun.param, "write")) {
+            if (varargs) {
                 gen_write_nil();
             }
             LOG_DEBUG_M("TYPE/KW nil ok");
@@ -209,7 +229,7 @@ static token_t term_seq_1(token_t token, context_t *ctx)
 
     if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == COMMA) {
@@ -236,7 +256,7 @@ static token_t term_seq(token_t token, context_t *ctx)
 
     } else if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == INTEGER) {
@@ -297,19 +317,19 @@ static token_t call(token_t token, context_t *ctx)
             // implicit conv integer->number is done in term()
             token = term_seq(token, ctx);
 
-            if (!strcmp(fun_id->fun.param, "write")) {
+            if (fun_id->fun.param.varargs) {
                 LOG_DEBUG_M("Function write does not need signature check");
-            } else if (strcmp(string_expose(ctx->param), fun_id->fun.param)) {
+            } else if (!signature_equal(ctx->param, fun_id->fun.param)) {
                 LOG_ERROR("Parameters '%s' do not match what %s() takes: '%s'",
-                        string_expose(ctx->param),
+                        SIGNATURE_STRING(ctx->param),
                         fun_id->name,
-                        fun_id->fun.param);
+                        SIGNATURE_STRING(fun_id->fun.param));
                 exit(EFUNCALL);
             }
             LOG_DEBUG("after term_seq(): param '%s'",
-                    string_expose(ctx->param));
+                    SIGNATURE_STRING(ctx->param));
 
-            string_clear(ctx->param);
+            signature_clear(&ctx->param);
 
             token = get_next_token(ctx);
 
@@ -320,7 +340,7 @@ static token_t call(token_t token, context_t *ctx)
 
             // write() is generated by calls for each term,
             // so don't call it as a whole
-            if (strcmp(fun_id->fun.param, "write")) {
+            if (!fun_id->fun.param.varargs) {
                 gen_call(fun_id);
             }
 
@@ -382,28 +402,28 @@ static token_t type_list_1(token_t token, context_t *ctx)
             if (*token.keyword == KW_INTEGER) {
                 LOG_DEBUG_M("integer diving");
                 token = type(token, ctx);
-                string_appendc(ctx->param, 'i');
+                append_type(ctx, &ctx->param, VAR_INTEGER);
                 token = type_list_1(token, ctx);
                 return token;
 
             } else if (*token.keyword == KW_NUMBER) {
                 LOG_DEBUG_M("number diving");
                 token = type(token, ctx);
-                string_appendc(ctx->param, 'n');
+                append_type(ctx, &ctx->param, VAR_NUMBER);
                 token = type_list_1(token, ctx);
                 return token;
 
             } else if (*token.keyword == KW_STRING) {
                 LOG_DEBUG_M("string diving");
                 token = type(token, ctx);
-                string_appendc(ctx->param, 's');
+                append_type(ctx, &ctx->param, VAR_STRING);
                 token = type_list_1(token, ctx);
                 return token;
             }
         }
     } else if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
     }
 
@@ -419,27 +439,27 @@ static token_t type_list(token_t token, context_t *ctx)
         if (*token.keyword == KW_INTEGER) {
             LOG_DEBUG_M("integer diving");
             token = type(token, ctx);
-            string_appendc(ctx->param, 'i');
+            append_type(ctx, &ctx->param, VAR_INTEGER);
             token = type_list_1(token, ctx);
             return token;
 
         } else if (*token.keyword == KW_NUMBER) {
             LOG_DEBUG_M("number diving");
             token = type(token, ctx);
-            string_appendc(ctx->param, 'n');
+            append_type(ctx, &ctx->param, VAR_NUMBER);
             token = type_list_1(token, ctx);
             return token;
 
         } else if (*token.keyword == KW_STRING) {
             LOG_DEBUG_M("string diving");
             token = type(token, ctx);
-            string_appendc(ctx->param, 's');
+            append_type(ctx, &ctx->param, VAR_STRING);
             token = type_list_1(token, ctx);
             return token;
         }
     } else if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
     }
 
@@ -459,7 +479,7 @@ static token_t fun_ret_list_1(token_t token, context_t *ctx)
             if (*token.keyword == KW_INTEGER) {
                 LOG_DEBUG_M("integer diving");
                 token = type(token, ctx);
-                string_appendc(ctx->retval, VAR_INTEGER);
+                append_type(ctx, &ctx->retval, VAR_INTEGER);
                 if (ctx->saved_id->type == FUNCTION)
                     gen_var_retval();
                 token = fun_ret_list_1(token, ctx);
@@ -468,7 +488,7 @@ static token_t fun_ret_list_1(token_t token, context_t *ctx)
             } else if (*token.keyword == KW_NUMBER) {
                 LOG_DEBUG_M("number diving");
                 token = type(token, ctx);
-                string_appendc(ctx->retval, VAR_NUMBER);
+                append_type(ctx, &ctx->retval, VAR_NUMBER);
                 if (ctx->saved_id->type == FUNCTION)
                     gen_var_retval();
                 token = fun_ret_list_1(token, ctx);
@@ -477,7 +497,7 @@ static token_t fun_ret_list_1(token_t token, context_t *ctx)
             } else if (*token.keyword == KW_STRING) {
                 LOG_DEBUG_M("string diving");
                 token = type(token, ctx);
-                string_appendc(ctx->retval, VAR_STRING);
+                append_type(ctx, &ctx->retval, VAR_STRING);
                 if (ctx->saved_id->type == FUNCTION)
                     gen_var_retval();
                 token = fun_ret_list_1(token, ctx);
@@ -486,48 +506,48 @@ static token_t fun_ret_list_1(token_t token, context_t *ctx)
         }
     } else if (token.type == IDENTIFIER) {
         LOG_DEBUG_M("id unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == END) {
         LOG_DEBUG_M("$ unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == KEYWORD) {
         if (*token.keyword == KW_GLOBAL) {
             LOG_DEBUG_M("global unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_FUNCTION) {
             LOG_DEBUG_M("function unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_RETURN) {
             LOG_DEBUG_M("return unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_LOCAL) {
             LOG_DEBUG_M("local unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_IF) {
             LOG_DEBUG_M("if unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_WHILE) {
             LOG_DEBUG_M("while unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -544,7 +564,7 @@ static token_t fun_ret_list(token_t token, context_t *ctx)
         if (*token.keyword == KW_INTEGER) {
             LOG_DEBUG_M("integer diving");
             token = type(token, ctx);
-            string_appendc(ctx->retval, VAR_INTEGER);
+            append_type(ctx, &ctx->retval, VAR_INTEGER);
             LOG_DEBUG("fun_ret_list() integer: saved_id->type: %d", ctx->saved_id->type);
             debug_identifier(ctx->saved_id);
             if (ctx->saved_id->type == FUNCTION)
@@ -555,7 +575,7 @@ static token_t fun_ret_list(token_t token, context_t *ctx)
         } else if (*token.keyword == KW_NUMBER) {
             LOG_DEBUG_M("number diving");
             token = type(token, ctx);
-            string_appendc(ctx->retval, VAR_NUMBER);
+            append_type(ctx, &ctx->retval, VAR_NUMBER);
             if (ctx->saved_id->type == FUNCTION)
                 gen_var_retval();
             token = fun_ret_list_1(token, ctx);
@@ -564,7 +584,7 @@ static token_t fun_ret_list(token_t token, context_t *ctx)
         } else if (*token.keyword == KW_STRING) {
             LOG_DEBUG_M("string diving");
             token = type(token, ctx);
-            string_appendc(ctx->retval, VAR_STRING);
+            append_type(ctx, &ctx->retval, VAR_STRING);
             if (ctx->saved_id->type == FUNCTION)
                 gen_var_retval();
             token = fun_ret_list_1(token, ctx);
@@ -588,48 +608,48 @@ static token_t fun_ret(token_t token, context_t *ctx)
 
     } else if (token.type == END) {
         LOG_DEBUG_M("$ unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == IDENTIFIER) {
         LOG_DEBUG_M("id unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == KEYWORD) {
         if (*token.keyword == KW_GLOBAL) {
             LOG_DEBUG_M("global unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_FUNCTION) {
             LOG_DEBUG_M("function unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_RETURN) {
             LOG_DEBUG_M("return unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_LOCAL) {
             LOG_DEBUG_M("local unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_IF) {
             LOG_DEBUG_M("if unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_WHILE) {
             LOG_DEBUG_M("while unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -642,7 +662,6 @@ static token_t e_1(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
     enum variable_type expr_type;
-    int retval_index;
 
     if (token.type == COMMA) {
         LOG_DEBUG_M(", ok");
@@ -653,20 +672,19 @@ static token_t e_1(token_t token, context_t *ctx)
         expr_type = expr_parser_start(ctx);
         LOG_DEBUG("expr is '%c'", expr_type);
 
-        retval_index = strlen(string_expose(ctx->retval));
         LOG_DEBUG("e_1() retval_index: %d, expr: %c, retval: '%s'",
-                retval_index,
+                ctx->retval.len,
                 expr_type,
-                string_expose(ctx->retval));
+                SIGNATURE_STRING(ctx->retval));
 
-        if (ctx->saved_id->fun.retval[retval_index] == VAR_NUMBER &&
+        if (signature_type(ctx->saved_id->fun.retval, ctx->retval.len) == VAR_NUMBER &&
                 expr_type == VAR_INTEGER) {
             LOG_DEBUG_M("will do implicit conv for expr result");
             gen_conv_to_number_top();
             expr_type = VAR_NUMBER;
         }
 
-        string_appendc(ctx->retval, expr_type);
+        append_type(ctx, &ctx->retval, expr_type);
 
         gen_var_active_assign(ctx->main_symqueue, true);
 
@@ -677,38 +695,38 @@ static token_t e_1(token_t token, context_t *ctx)
         return token;
     } else if (token.type == IDENTIFIER) {
         LOG_DEBUG_M("id unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
 
     } else if (token.type == KEYWORD) {
         if (*token.keyword == KW_RETURN) {
             LOG_DEBUG_M("return unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_LOCAL) {
             LOG_DEBUG_M("local unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_IF) {
             LOG_DEBUG_M("if unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_ELSE) {
             LOG_DEBUG_M("else unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_WHILE) {
             LOG_DEBUG_M("while unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -721,26 +739,22 @@ static token_t e_list(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
     enum variable_type expr_type;
-    int retval_index;
 
-    token = get_next_token(ctx);
+    token = peek_token(ctx, 0);
     if (token.type == KEYWORD) {
         LOG_DEBUG_M("empty return statement");
-        unget_token(token);
         return token;
     }
-    unget_token(token);
 
     expr_type = expr_parser_start(ctx);
     LOG_DEBUG("expr is '%c'", expr_type);
 
-    retval_index = strlen(string_expose(ctx->retval));
     LOG_DEBUG("e_list() after first expr, retval '%s' len: %d",
-            string_expose(ctx->retval),
-            retval_index);
+            SIGNATURE_STRING(ctx->retval),
+            ctx->retval.len);
 
     // conv if corresponding LHS type is number and we are integer
-    if (ctx->saved_id->fun.retval[retval_index] == VAR_NUMBER &&
+    if (signature_type(ctx->saved_id->fun.retval, ctx->retval.len) == VAR_NUMBER &&
             expr_type == VAR_INTEGER) {
         LOG_DEBUG_M("will do implicit conv for expr result");
         gen_conv_to_number_top();
@@ -748,7 +762,7 @@ static token_t e_list(token_t token, context_t *ctx)
     }
 
 
-    string_appendc(ctx->retval, expr_type);
+    append_type(ctx, &ctx->retval, expr_type);
     LOG_DEBUG_M("e_list: saved_id:");
     debug_identifier(ctx->saved_id);
 
@@ -775,7 +789,7 @@ static token_t ret_e_list(token_t token, context_t *ctx)
     // can be used to retrive `retval` for checking return types
     LOG_DEBUG("ret_e_list() with saved_id: %s", ctx->saved_id->name);
 
-    int retval_len = (int)strlen(ctx->saved_id->fun.retval);
+    int retval_len = ctx->saved_id->fun.retval.len;
     // this arrays is local, used for creating "fake" identifiers
     // to put '%retval_n' to symqueue
     // all of them should be popped and used in e_list()
@@ -798,16 +812,16 @@ static token_t ret_e_list(token_t token, context_t *ctx)
     token = e_list(token, ctx);
 
     // implicit conv if returning integer when number expected is done in e_list()
-    LOG_DEBUG("ret_e_list: retval '%s'", string_expose(ctx->retval));
+    LOG_DEBUG("ret_e_list: retval '%s'", SIGNATURE_STRING(ctx->retval));
     debug_identifier(ctx->saved_id);
 
-    if (strcmp(string_expose(ctx->retval), ctx->saved_id->fun.retval)) {
+    if (!signature_equal(ctx->retval, ctx->saved_id->fun.retval)) {
         LOG_ERROR("Return statement(s) '%s' do not match function return values '%s'",
-                string_expose(ctx->retval), ctx->saved_id->fun.retval);
+                SIGNATURE_STRING(ctx->retval), SIGNATURE_STRING(ctx->saved_id->fun.retval));
         exit(EFUNCALL);
     }
 
-    string_clear(ctx->retval);
+    signature_clear(&ctx->retval);
 
     debug_token(token);
     return token;
@@ -850,14 +864,14 @@ static token_t id_seq_1(token_t token, context_t *ctx)
             LOG_DEBUG_M("id ok");
             debug_token(token);
             gen_var_set_active(token.identifier, ctx->main_symqueue);
-            string_appendc(ctx->param, token.identifier->var.type);
+            append_type(ctx, &ctx->param, token.identifier->var.type);
             token = get_next_token(ctx);
             token = id_seq_1(token, ctx);
             return token;
         }
     } else if (token.type == ASSIGNMENT) {
         LOG_DEBUG_M("= unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
     }
     exit(ESYNTAX);
@@ -878,7 +892,7 @@ static token_t id_seq(token_t token, context_t *ctx)
         debug_token(token);
 
         gen_var_set_active(token.identifier, ctx->main_symqueue);
-        string_appendc(ctx->param, token.identifier->var.type);
+        append_type(ctx, &ctx->param, token.identifier->var.type);
         token = get_next_token(ctx);
         token = id_seq_1(token, ctx);
         return token;
@@ -891,7 +905,7 @@ static token_t stmt(token_t token, context_t *ctx)
 {
     LOG_DEBUG_M();
     debug_token(token);
-    char *saved_LHS;
+    signature_t saved_LHS;
     identifier_t *backup;
 
     if (token.type == IDENTIFIER) {
@@ -900,13 +914,8 @@ static token_t stmt(token_t token, context_t *ctx)
         token = id_seq(token, ctx);
 
         LOG_DEBUG("id_seq() returned LSH: '%s'\n",
-                string_expose(ctx->param));
-        saved_LHS = string_export(ctx->param);
-
-        int saved_LHS_len = strlen(saved_LHS);
-        bool conv_returned[saved_LHS_len];
-        for (int i = 0; i < saved_LHS_len; i++)
-            conv_returned[i] = false;
+                SIGNATURE_STRING(ctx->param));
+        saved_LHS = ctx->param;
 
         token = get_next_token(ctx);
 
@@ -914,61 +923,54 @@ static token_t stmt(token_t token, context_t *ctx)
             exit(ESYNTAX);
         LOG_DEBUG_M("= ok");
 
-        token = get_next_token(ctx);
+        // RHS could be a function call or an expression list, the first token decides
+        token = peek_token(ctx, 0);
         debug_token(token);
 
         if (token.type == IDENTIFIER) {
-            string_clear(ctx->param);
-            identifier_t *fun_id = symtable_find(symstack_global_symtable(ctx->symstack),
-                                                token.identifier->name);
+            signature_clear(&ctx->param);
+            identifier_t *fun_id = symstack_find_global(ctx->symstack, token.identifier->atom);
             if (fun_id) {
-                if ((int)strlen(fun_id->fun.retval) < saved_LHS_len) {
+                if (fun_id->fun.retval.len < saved_LHS.len) {
                     LOG_ERROR("%s():'%s' does not return enough values to fill LHS '%s'",
                             fun_id->name,
-                            fun_id->fun.retval,
-                            saved_LHS);
+                            SIGNATURE_STRING(fun_id->fun.retval),
+                            SIGNATURE_STRING(saved_LHS));
                     exit(EFUNCALL);
                 }
                 // check LHS (saved in ctx->param) is prefix of function's retval
                 LOG_DEBUG("LHS '%s' (ctx->param '%s') %s() retval '%s'",
-                        saved_LHS, string_expose(ctx->param), fun_id->name, fun_id->fun.retval);
-
-                for (int i = 0; i < saved_LHS_len; i++) {
-                    if (saved_LHS[i] == VAR_NUMBER && fun_id->fun.retval[i] == VAR_INTEGER) {
-                        conv_returned[i] = true;
-                        LOG_DEBUG("will apply implicit conv at index %d", i);
-                    } else if (saved_LHS[i] == fun_id->fun.retval[i]) {
-                        continue;
-                    } else {
-                        LOG_ERROR("LHS '%s' is not compatible with %s() return values '%s'",
-                                saved_LHS,
-                                fun_id->name,
-                                fun_id->fun.retval);
-                        exit(EFUNCALL);
-                    }
+                        SIGNATURE_STRING(saved_LHS), SIGNATURE_STRING(ctx->param), fun_id->name,
+                        SIGNATURE_STRING(fun_id->fun.retval));
+
+                // integers returned to numbers are converted
+                if (!signature_assignable(saved_LHS, fun_id->fun.retval)) {
+                    LOG_ERROR("LHS '%s' is not compatible with %s() return values '%s'",
+                            SIGNATURE_STRING(saved_LHS),
+                            fun_id->name,
+                            SIGNATURE_STRING(fun_id->fun.retval));
+                    exit(EFUNCALL);
                 }
                 LOG_DEBUG("ok, we can call %s()", fun_id->name);
 
+                token = get_next_token(ctx);
                 token.identifier = fun_id;
                 backup = ctx->saved_id;
                 ctx->saved_id = fun_id;
                 token = call(token, ctx);
                 ctx->saved_id = backup;
 
-                for (int i = 0; i < saved_LHS_len; i++) {
-                    gen_returned_assign(ctx->main_symqueue, conv_returned[i]);
+                for (unsigned i = 0; i < saved_LHS.len; i++) {
+                    gen_returned_assign(ctx->main_symqueue, signature_converts(saved_LHS, fun_id->fun.retval, i));
                 }
 
                 assert(symqueue_is_empty(ctx->main_symqueue));
-                free(saved_LHS);
 
                 return token;
             }
         }
 
         // RHS is expression list
-        unget_token(token);
-
         // make fake identifier and save it in context for e_list()
         // so it thinks we are in a function that returns our LHS
         backup = ctx->saved_id;
@@ -985,22 +987,19 @@ static token_t stmt(token_t token, context_t *ctx)
         ctx->saved_id = backup;
 
         LOG_DEBUG("stmt analyzed: '%s' = '%s'",
-                saved_LHS,
-                string_expose(ctx->retval));
+                SIGNATURE_STRING(saved_LHS),
+                SIGNATURE_STRING(ctx->retval));
 
-        if (strcmp(saved_LHS, string_expose(ctx->retval))) {
+        if (!signature_equal(saved_LHS, ctx->retval)) {
             LOG_ERROR("LHS types '%s' do not match RHS types '%s'",
-                    saved_LHS,
-                    string_expose(ctx->retval));
+                    SIGNATURE_STRING(saved_LHS),
+                    SIGNATURE_STRING(ctx->retval));
             exit(EASSIGN);
         }
 
         assert(symqueue_is_empty(ctx->main_symqueue));
-        string_clear(ctx->param);
-        string_clear(ctx->retval);
-
-        if (saved_LHS)
-            free(saved_LHS);
+        signature_clear(&ctx->param);
+        signature_clear(&ctx->retval);
 
         return token;
     }
@@ -1013,102 +1012,97 @@ static token_t var_assign(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
     enum variable_type expr_type;
-    char expr_type_string[2];
-    char *saved_LHS;
+    signature_t saved_LHS;
 
     if (token.type == ASSIGNMENT) {
-        saved_LHS = string_export(ctx->param);
-        token = get_next_token(ctx);
+        saved_LHS = ctx->param;
+        // RHS could be a function call or an expression, the first token decides
+        token = peek_token(ctx, 0);
 
         if (token.type == IDENTIFIER) {
-            string_clear(ctx->param);
-            identifier_t *fun_id = symtable_find(symstack_global_symtable(ctx->symstack),
-                                                token.identifier->name);
+            signature_clear(&ctx->param);
+            identifier_t *fun_id = symstack_find_global(ctx->symstack, token.identifier->atom);
             if (fun_id) {
-                if (strncmp(saved_LHS, fun_id->fun.retval, strlen(saved_LHS))) {
+                if (!signature_is_prefix(saved_LHS, fun_id->fun.retval)) {
                     LOG_ERROR("Variable type '%s' is not compatible with %s(), which returns '%s'",
-                            saved_LHS,
+                            SIGNATURE_STRING(saved_LHS),
                             fun_id->name,
-                            fun_id->fun.retval);
+                            SIGNATURE_STRING(fun_id->fun.retval));
                     exit(EFUNCALL);
                 }
                 LOG_DEBUG("ok, we can call %s()", fun_id->name);
+                token = get_next_token(ctx);
                 token.identifier = fun_id;
                 token = call(token, ctx);
 
                 gen_returned_assign(ctx->main_symqueue, false);
                 assert(symqueue_is_empty(ctx->main_symqueue));
-                free(saved_LHS);
 
                 return token;
             }
         }
         // RHS is single expression
-
-        unget_token(token);
         LOG_DEBUG_M("...expression code");
         expr_type = expr_parser_start(ctx);
 
         LOG_DEBUG("var_assing after expr: LHS '%s' expr_type '%c'",
-                saved_LHS, expr_type);
-        if (saved_LHS[0] == 'n' && expr_type == 'i') {
+                SIGNATURE_STRING(saved_LHS), expr_type);
+        if (signature_type(saved_LHS, 0) == VAR_NUMBER && expr_type == VAR_INTEGER) {
             gen_conv_to_number_top();
-            expr_type = 'n';
+            expr_type = VAR_NUMBER;
         }
 
-        snprintf(expr_type_string, 2, "%c", expr_type);
-        if (strcmp(saved_LHS, expr_type_string)) {
-            LOG_ERROR("expr type '%s' doesn't match variable type '%s'",
-                    expr_type_string, saved_LHS);
+        if (saved_LHS.len != 1 || signature_type(saved_LHS, 0) != expr_type) {
+            LOG_ERROR("expr type '%c' doesn't match variable type '%s'",
+                    expr_type, SIGNATURE_STRING(saved_LHS));
             exit(EASSIGN);
         }
         // generate
         gen_var_dec_assign(ctx->main_symqueue, true);
-        free(saved_LHS);
 
         return token;
 
     } else if (token.type == IDENTIFIER) {
             LOG_DEBUG_M("id unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
     } else if (token.type == KEYWORD) {
         if (*token.keyword == KW_RETURN) {
             LOG_DEBUG_M("return unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_LOCAL) {
             LOG_DEBUG_M("local unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_IF) {
             LOG_DEBUG_M("if unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_ELSE) {
             LOG_DEBUG_M("else unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_WHILE) {
             LOG_DEBUG_M("while unget and return");
             gen_var_dec_assign(ctx->main_symqueue, false);
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -1121,7 +1115,6 @@ static token_t var_dec(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
 
-    symtable_t *symtable = symstack_global_symtable(ctx->symstack);
     identifier_t *backup = ctx->saved_id;
 
     if (token.type == KEYWORD) {
@@ -1131,13 +1124,11 @@ static token_t var_dec(token_t token, context_t *ctx)
             if (token.type == IDENTIFIER) {
                 ctx->saved_id = token.identifier;
 
-                if (symtable_find(symtable, ctx->saved_id->name)) {
+                if (symstack_find_global(ctx->symstack, ctx->saved_id->atom)) {
                     LOG_ERROR("%s is already a function", ctx->saved_id->name);
                     exit(EDEF);
                 }
-                symstack_most_local(ctx->symstack);
-                symtable = symstack_get(ctx->symstack);
-                if (symtable_find(symtable, ctx->saved_id->name) && ctx->saved_id->type == VARIABLE) {
+                if (symstack_find_local(ctx->symstack, ctx->saved_id->atom) && ctx->saved_id->type == VARIABLE) {
                     LOG_ERROR("%s is already a variable", ctx->saved_id->name);
                     exit(EDEF);
                 }
@@ -1154,7 +1145,7 @@ static token_t var_dec(token_t token, context_t *ctx)
                     token = get_next_token(ctx);
                     token = type(token, ctx);
                     debug_identifier(ctx->saved_id);
-                    string_appendc(ctx->param, ctx->saved_id->var.type);
+                    append_type(ctx, &ctx->param, ctx->saved_id->var.type);
                     ctx->saved_id = backup;
                     return token;
                 }
@@ -1175,9 +1166,9 @@ static token_t var_dec_def(token_t token, context_t *ctx)
             LOG_DEBUG_M("local diving");
             token = var_dec(token, ctx);
             LOG_DEBUG("param after var_dec(): '%s'",
-                    string_expose(ctx->param));
+                    SIGNATURE_STRING(ctx->param));
             token = var_assign(token, ctx);
-            string_clear(ctx->param);
+            signature_clear(&ctx->param);
             return token;
         }
     }
@@ -1197,8 +1188,7 @@ static token_t body_1(token_t token, context_t *ctx)
 
     if (token.type == IDENTIFIER) {
         LOG_DEBUG_M("id diving");
-        identifier_t *fun_id = symtable_find(symstack_global_symtable(ctx->symstack),
-                                            token.identifier->name);
+        identifier_t *fun_id = symstack_find_global(ctx->symstack, token.identifier->atom);
         if (fun_id) {
             // write() handled by swapping saved_id
             // call, but there is no LHS
@@ -1286,12 +1276,12 @@ static token_t body_2(token_t token, context_t *ctx)
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_ELSE) {
             LOG_DEBUG_M("else unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -1342,12 +1332,12 @@ static token_t body(token_t token, context_t *ctx)
 
         } else if (*token.keyword == KW_ELSE) {
             LOG_DEBUG_M("else unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
 
         } else if (*token.keyword == KW_END) {
             LOG_DEBUG_M("end unget and return");
-            unget_token(token);
+            unget_token(ctx, token);
             return token;
         }
     }
@@ -1360,9 +1350,6 @@ static token_t if_(token_t token, context_t *ctx)
     debug_token(token);
 
     unsigned int if_cnt;
-    symtable_t *then_symtable = symtable_create();
-    symtable_t *else_symtable = symtable_create();
-    symtable_t *popped;
 
     if (token.type == KEYWORD) {
         if (*token.keyword == KW_IF) {
@@ -1380,8 +1367,9 @@ static token_t if_(token_t token, context_t *ctx)
 
             LOG_DEBUG_M("then ok");
 
-            // local symtable for new block
-            symstack_push(ctx->symstack, then_symtable);
+            // local scope for new block
+            if (symstack_push_scope(ctx->symstack) < 0)
+                exit(EINTERNAL);
 
             token = get_next_token(ctx);
 
@@ -1389,12 +1377,10 @@ static token_t if_(token_t token, context_t *ctx)
 
             token = get_next_token(ctx);
 
-            popped = symstack_pop(ctx->symstack);
-            if (popped != then_symtable) {
-                LOG_ERROR_M("Wrong popped symtable at `then` block end.");
+            if (symstack_pop_scope(ctx->symstack) < 0) {
+                LOG_ERROR_M("No scope to leave at `then` block end.");
                 exit(EINTERNAL);
             }
-            symtable_destroy(then_symtable);
 
             if (token.type != KEYWORD)
                 exit(ESYNTAX);
@@ -1403,8 +1389,9 @@ static token_t if_(token_t token, context_t *ctx)
 
             LOG_DEBUG_M("else ok");
 
-            // local symtable for new block
-            symstack_push(ctx->symstack, else_symtable);
+            // local scope for new block
+            if (symstack_push_scope(ctx->symstack) < 0)
+                exit(EINTERNAL);
 
             gen_if_else(if_cnt);
 
@@ -1414,12 +1401,10 @@ static token_t if_(token_t token, context_t *ctx)
 
             token = get_next_token(ctx);
 
-            popped = symstack_pop(ctx->symstack);
-            if (popped != else_symtable) {
-                LOG_ERROR_M("Wrong popped symtable at `else` block end");
+            if (symstack_pop_scope(ctx->symstack) < 0) {
+                LOG_ERROR_M("No scope to leave at `else` block end");
                 exit(EINTERNAL);
             }
-            symtable_destroy(else_symtable);
 
             if (token.type != KEYWORD)
                 exit(ESYNTAX);
@@ -1442,8 +1427,6 @@ static token_t while_(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
 
-    symtable_t *local_symtable = symtable_create();
-    symtable_t *popped;
     unsigned int while_cnt;
 
     if (token.type == KEYWORD) {
@@ -1464,8 +1447,9 @@ static token_t while_(token_t token, context_t *ctx)
                 exit(ESYNTAX);
             LOG_DEBUG_M("do ok");
 
-            // local symtable for new block
-            symstack_push(ctx->symstack, local_symtable);
+            // local scope for new block
+            if (symstack_push_scope(ctx->symstack) < 0)
+                exit(EINTERNAL);
 
             token = get_next_token(ctx);
 
@@ -1473,12 +1457,10 @@ static token_t while_(token_t token, context_t *ctx)
 
             token = get_next_token(ctx);
 
-            popped = symstack_pop(ctx->symstack);
-            if (popped != local_symtable) {
-                LOG_ERROR_M("Wrong popped symtable at `while` block end.");
+            if (symstack_pop_scope(ctx->symstack) < 0) {
+                LOG_ERROR_M("No scope to leave at `while` block end.");
                 exit(EINTERNAL);
             }
-            symtable_destroy(local_symtable);
 
             if (token.type != KEYWORD)
                 exit(ESYNTAX);
@@ -1502,10 +1484,8 @@ static token_t param(token_t token, context_t *ctx)
 
     identifier_t *saved_id;
 
-    symtable_t *global = symstack_global_symtable(ctx->symstack);
-
     if (token.type == IDENTIFIER) {
-        if (symtable_find(global, token.identifier->name)) {
+        if (symstack_find_global(ctx->symstack, token.identifier->atom)) {
             LOG_ERROR("%s is already a function", token.identifier->name);
             exit(EDEF);
         }
@@ -1528,21 +1508,21 @@ static token_t param(token_t token, context_t *ctx)
                 if (*token.keyword == KW_INTEGER) {
                     LOG_DEBUG_M("integer diving");
                     token = type(token, ctx);
-                    string_appendc(ctx->param, VAR_INTEGER);
+                    append_type(ctx, &ctx->param, VAR_INTEGER);
                     saved_id->var.type = VAR_INTEGER;
                     LOG_DEBUG("var '%s' set to integer", saved_id->name);
                     return token;
                 } else if (*token.keyword == KW_NUMBER) {
                     LOG_DEBUG_M("number diving");
                     token = type(token, ctx);
-                    string_appendc(ctx->param, VAR_NUMBER);
+                    append_type(ctx, &ctx->param, VAR_NUMBER);
                     saved_id->var.type = VAR_NUMBER;
                     LOG_DEBUG("var '%s' set to number", saved_id->name);
                     return token;
                 } else if (*token.keyword == KW_STRING) {
                     LOG_DEBUG_M("string diving");
                     token = type(token, ctx);
-                    string_appendc(ctx->param, VAR_STRING);
+                    append_type(ctx, &ctx->param, VAR_STRING);
                     saved_id->var.type = VAR_STRING;
                     LOG_DEBUG("var '%s' set to string", saved_id->name);
                     return token;
@@ -1569,7 +1549,7 @@ static token_t param_1(token_t token, context_t *ctx)
 
     } else if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
     }
 
@@ -1589,7 +1569,7 @@ static token_t param_list(token_t token, context_t *ctx)
 
     } else if (token.type == RIGHT_PAR) {
         LOG_DEBUG_M(") unget and return");
-        unget_token(token);
+        unget_token(ctx, token);
         return token;
     }
 
@@ -1626,13 +1606,13 @@ static token_t fun_def(token_t token, context_t *ctx)
                     exit(ESYNTAX);
                 LOG_DEBUG_M("( ok");
 
-                symtable_t *local_symtable = symtable_create();
-                symstack_push(ctx->symstack, local_symtable);
+                if (symstack_push_scope(ctx->symstack) < 0)
+                    exit(EINTERNAL);
 
                 token = get_next_token(ctx);
 
                 token = param_list(token, ctx);
-                LOG_DEBUG("param from param_list() '%s'", string_expose(ctx->param));
+                LOG_DEBUG("param from param_list() '%s'", SIGNATURE_STRING(ctx->param));
 
                 token = get_next_token(ctx);
 
@@ -1652,20 +1632,20 @@ static token_t fun_def(token_t token, context_t *ctx)
                 } else {
                     token = fun_ret(token, ctx);
                 }
-                LOG_DEBUG("retval from fun_ret() '%s'", string_expose(ctx->retval));
+                LOG_DEBUG("retval from fun_ret() '%s'", SIGNATURE_STRING(ctx->retval));
 
                 // export, check and set bot param and retval
                 // before we dive into body
                 if (ctx->saved_id->type == FUNCTION) {
-                    if (ctx->saved_id->fun.defined) {
+                    if (ctx->saved_id->defined) {
                         LOG_ERROR("%s() redefinition", ctx->saved_id->name);
                         exit(EDEF);
                     }
-                    if (strcmp(ctx->saved_id->fun.param, string_expose(ctx->param))) {
+                    if (!signature_equal(ctx->saved_id->fun.param, ctx->param)) {
                         LOG_ERROR("%s() parameters do not match declaration", ctx->saved_id->name);
                         exit(EDEF);
                     }
-                    if (strcmp(ctx->saved_id->fun.retval, string_expose(ctx->retval))) {
+                    if (!signature_equal(ctx->saved_id->fun.retval, ctx->retval)) {
                         LOG_ERROR("%s() return values do not match declaration", ctx->saved_id->name);
                         exit(EDEF);
                     }
@@ -1679,10 +1659,10 @@ static token_t fun_def(token_t token, context_t *ctx)
                     ctx->saved_id->type = FUNCTION;
                     LOG_DEBUG("%s() set as function", ctx->saved_id->name);
                 }
-                ctx->saved_id->fun.param = string_export(ctx->param);
-                ctx->saved_id->fun.retval = string_export(ctx->retval);
-                string_clear(ctx->param);
-                string_clear(ctx->retval);
+                ctx->saved_id->fun.param = ctx->param;
+                ctx->saved_id->fun.retval = ctx->retval;
+                signature_clear(&ctx->param);
+                signature_clear(&ctx->retval);
 
                 token = get_next_token(ctx);
 
@@ -1696,15 +1676,13 @@ static token_t fun_def(token_t token, context_t *ctx)
                     if (*token.keyword == KW_END) {
                         LOG_DEBUG_M("end returning");
 
-                        symtable_t *popped = symstack_pop(ctx->symstack);
-                        if (popped != local_symtable) {
-                            LOG_ERROR_M("Wrong popped symtable at `function` block end");
+                        if (symstack_pop_scope(ctx->symstack) < 0) {
+                            LOG_ERROR_M("No scope to leave at `function` block end");
                             exit(EINTERNAL);
                         }
-                        symtable_destroy(local_symtable);
 
                         // saved function identifer because ctx->saved_id is rewritten by body
-                        function_id->fun.defined = 1; 
+                        function_id->defined = 1; 
                         debug_identifier(function_id);
 
                         // generate
@@ -1750,10 +1728,10 @@ static token_t fun_signature(token_t token, context_t *ctx)
 
             token = fun_ret(token, ctx);
 
-            ctx->saved_id->fun.param = string_export(ctx->param);
-            ctx->saved_id->fun.retval = string_export(ctx->retval);
-            string_clear(ctx->param);
-            string_clear(ctx->retval);
+            ctx->saved_id->fun.param = ctx->param;
+            ctx->saved_id->fun.retval = ctx->retval;
+            signature_clear(&ctx->param);
+            signature_clear(&ctx->retval);
 
             return token;
         }
@@ -1778,8 +1756,7 @@ static token_t fun_dec(token_t token, context_t *ctx)
 
                 ctx->saved_id = token.identifier;
 
-                symtable_t *global_symtable = symstack_global_symtable(ctx->symstack);
-                if (symtable_find(global_symtable, ctx->saved_id->name) && ctx->saved_id->type == FUNCTION) {
+                if (symstack_find_global(ctx->symstack, ctx->saved_id->atom) && ctx->saved_id->type == FUNCTION) {
                     LOG_DEBUG("%s() is already a function", ctx->saved_id->name);
                     exit(EDEF);
                 }
@@ -1809,8 +1786,6 @@ static token_t code_1(token_t token, context_t *ctx)
     LOG_DEBUG_M();
     debug_token(token);
 
-    symtable_t *global = symstack_global_symtable(ctx->symstack);
-
     if (token.type == KEYWORD) {
         if (*token.keyword == KW_GLOBAL) {
             LOG_DEBUG_M("global diving");
@@ -1824,7 +1799,7 @@ static token_t code_1(token_t token, context_t *ctx)
         }
     } else if (token.type == IDENTIFIER) {
         // really? it can be only declared and definition might follow, right?
-        if (!symtable_find(global, token.identifier->name)) {
+        if (!symstack_find_global(ctx->symstack, token.identifier->atom)) {
             LOG_ERROR("%s() is not defined/declared function, cannot be called",
                     token.identifier->name);
             exit(EDEF);
@@ -1925,7 +1900,8 @@ static token_t require(token_t token, context_t *ctx)
             if (token.type == STRING) {
                 if(!strcmp(token.string, "ifj21")) {
                     LOG_DEBUG_M("\"ifj21\" ok");
-                    free(token.string);
+                    if (!ctx->literals)
+                        free(token.string);
 
                     // generate
                     gen_ifjcode21();
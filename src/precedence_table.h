@@ -0,0 +1,153 @@
+/**
+ * @file precedence_table.h
+ * Precedence table of expression parser
+ *
+ * GENERATED FILE, DON'T EDIT IT MANUALLY!
+ * Source: design/precedence_table.txt, generator: src/gen-precedence-table.sh
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _PRECEDENCE_TABLE_H_
+#define _PRECEDENCE_TABLE_H_
+
+#include "expr_parser.h"
+
+#include <stdint.h>
+
+/**
+ * Columns (and rows) of precedence table
+ *
+ * PC_NONE is a column of tokens, which can't be in expression (their operation is always R_END)
+ */
+enum prec_columns {
+    PC_NONE,
+    PC_STRLEN, // #
+    PC_MUL, // *
+    PC_DIV, // /
+    PC_INT_DIV, // //
+    PC_ADD, // +
+    PC_SUB, // -
+    PC_CONCAT, // ..
+    PC_LT, // <
+    PC_LEQ, // <=
+    PC_GT, // >
+    PC_GEQ, // >=
+    PC_EQ, // ==
+    PC_NEQ, // ~=
+    PC_LEFT_PAR, // (
+    PC_RIGHT_PAR, // )
+    PC_TERM, // i
+    PC_END, // $
+    PC_COUNT
+};
+
+/**
+ * Map of token types to columns of precedence table (unlisted tokens are in PC_NONE)
+ */
+static const uint8_t prec_columns[END + 1] = {
+    [STRLEN] = PC_STRLEN,
+    [MULTIPLICATION] = PC_MUL,
+    [DIVISION] = PC_DIV,
+    [INT_DIVISION] = PC_INT_DIV,
+    [ADDITION] = PC_ADD,
+    [SUBTRACTION] = PC_SUB,
+    [CONCAT] = PC_CONCAT,
+    [LT] = PC_LT,
+    [LEQ] = PC_LEQ,
+    [GT] = PC_GT,
+    [GEQ] = PC_GEQ,
+    [EQ] = PC_EQ,
+    [NEQ] = PC_NEQ,
+    [LEFT_PAR] = PC_LEFT_PAR,
+    [RIGHT_PAR] = PC_RIGHT_PAR,
+    [INTEGER] = PC_TERM,
+    [NUMBER] = PC_TERM,
+    [STRING] = PC_TERM,
+    [IDENTIFIER] = PC_TERM,
+    [KEYWORD] = PC_TERM,
+    [END] = PC_END,
+};
+
+/**
+ * Precedence table (token on the top of the stack x token on the input --> operation)
+ */
+static const uint8_t precedence_table[PC_COUNT][PC_COUNT] = {
+    [PC_NONE] = { // tokens out of expression
+        R_END, R_END, R_END, R_END, R_END, R_END, R_END, R_END, R_END,
+        R_END, R_END, R_END, R_END, R_END, R_END, R_END, R_END, R_END,
+    },
+    [PC_STRLEN] = { // #
+        R_END, R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_MUL] = { // *
+        R_END, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_DIV] = { // /
+        R_END, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_INT_DIV] = { // //
+        R_END, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_ADD] = { // +
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_SUB] = { // -
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_CONCAT] = { // ..
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_LT] = { // <
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_LEQ] = { // <=
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_GT] = { // >
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_GEQ] = { // >=
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_EQ] = { // ==
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_NEQ] = { // ~=
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON,
+        R_NON, R_NON, R_NON, R_NON, R_NON, R_SHT, R_RDC, R_SHT, R_RDC,
+    },
+    [PC_LEFT_PAR] = { // (
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT,
+        R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_PSH, R_SHT, R_NON,
+    },
+    [PC_RIGHT_PAR] = { // )
+        R_END, R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_NON, R_RDC, R_NON, R_RDC,
+    },
+    [PC_TERM] = { // i
+        R_END, R_NON, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_RDC,
+        R_RDC, R_RDC, R_RDC, R_RDC, R_RDC, R_NON, R_RDC, R_NON, R_RDC,
+    },
+    [PC_END] = { // $
+        R_END, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT,
+        R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_SHT, R_NON, R_SHT, R_NON,
+    },
+};
+
+#endif //_PRECEDENCE_TABLE_H_
@@ -2,7 +2,8 @@
  * @file scanner.c
  * Scanner (lexical analyzer)
  *
- * It loads code from stdin and parses it into tokens for syntactic analyzer
+ * It loads code from input source and parses it into tokens for syntactic analyzer.
+ * Lexemes are recognized by table-driven finite state machine (see scanner_fsm.h).
  *
  * IFJ and IAL project (IFJ21 compiler)
  * Team: 128 (variant II)
@@ -18,438 +19,655 @@
 #include "symstack.h"
 #include "context.h"
 #include "token.h"
+#include "source.h"
+#include "scanner_fsm.h"
+#include "strpool.h"
+#include "interner.h"
 
-#include <ctype.h>
-#include <stdio.h>
+#include <assert.h>
+#include <float.h>
+#include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 /**
- * Internal global variable for storing saved tokens
+ * Maximal number of significant digits stored in mantissa of numeric literal (10^19 < 2^64)
  */
-token_t saved_token = {0,};
+#define NUMBER_MAX_DIGITS 19
 /**
- * Is saved_token empty, so another token could be saved in there?
+ * Limit of the loaded exponent of numeric literal (bigger ones are converted by strtod() anyway)
  */
-bool token_cache_empty = true;
+#define NUMBER_MAX_EXPONENT 100000
+/**
+ * Mantissas up to this value are exactly representable in double
+ */
+#define NUMBER_MAX_EXACT_MANTISSA (UINT64_C(1) << 53)
+/**
+ * Is double arithmetic done exactly in double precision? (fast path of conversion needs it)
+ */
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define NUMBER_FAST_PATH true
+#else
+#define NUMBER_FAST_PATH false
+#endif
+
+/**
+ * Numeric literal being scanned (it's converted while digits are loaded)
+ *
+ * Content:
+ * <ul>
+ *      <li><code>start</code> - Position of the literal's first character in input source</li>
+ *      <li><code>mantissa</code> - Significant digits (leading zeros are skipped)</li>
+ *      <li><code>digits</code> - Number of digits in mantissa</li>
+ *      <li><code>truncated</code> - Some digits didn't fit into mantissa</li>
+ *      <li><code>scale</code> - Decimal exponent of the mantissa's last digit (without literal's exponent)</li>
+ *      <li><code>exponent_negative</code> - Has literal's exponent minus sign?</li>
+ *      <li><code>exponent</code> - Absolute value of literal's exponent</li>
+ * </ul>
+ */
+struct number_literal {
+    size_t start;
+    uint64_t mantissa;
+    int digits;
+    bool truncated;
+    int scale;
+    bool exponent_negative;
+    int exponent;
+};
+
+/**
+ * Powers of 10 exactly representable in double
+ */
+static const double exact_powers_of_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * The biggest exponent from exact_powers_of_10
+ */
+#define MAX_EXACT_POWER 22
+
+/**
+ * Makes \ddd escape sequence (ddd = ASCII position) of the character
+ */
+#define ESCAPE(c) [c] = {'\\', '0' + (c) / 100, '0' + (c) / 10 % 10, '0' + (c) % 10}
 
 /**
- * Finite state machine's states
+ * Escape sequences of characters, which need to be normalized in string literals
+ *
+ * Other characters have empty items (they're copied as they are).
  */
-enum fsm_states {
-    S_INIT,
-    S_SYMBOL,
-    S_INT, S_DEC, S_NUM, S_EXP, S_EXP_SIGN, S_NUM_EXP,
-    S_DIV, S_INT_DIV,
-    S_PLUS,
-    S_MUL,
-    S_GT, S_GE,
-    S_LT, S_LE,
-    S_ASSIGN, S_EQ,
-    S_TYPE_SPEC,
-    S_COMMA,
-    S_STRLEN,
-    S_LEFT_PAR,
-    S_RIGHT_PAR,
-    S_MINUS, S_DECIDE_COMM, S_LINE_COMM, S_ML_COMM_1, S_ML_COMM_2, S_ML_COMM_3,
-    S_STR_IN, S_STR_OUT, S_ESCAPE, S_ESCAPE_D, S_ESCAPE_DD,
-    S_CAT_1, S_CAT_2,
-    S_NE_1, S_NE_2
+static const char escape_sequences[256][4] = {
+    ESCAPE(0), ESCAPE(1), ESCAPE(2), ESCAPE(3), ESCAPE(4), ESCAPE(5), ESCAPE(6), ESCAPE(7), ESCAPE(8),
+    ESCAPE(9), ESCAPE(10), ESCAPE(11), ESCAPE(12), ESCAPE(13), ESCAPE(14), ESCAPE(15), ESCAPE(16),
+    ESCAPE(17), ESCAPE(18), ESCAPE(19), ESCAPE(20), ESCAPE(21), ESCAPE(22), ESCAPE(23), ESCAPE(24),
+    ESCAPE(25), ESCAPE(26), ESCAPE(27), ESCAPE(28), ESCAPE(29), ESCAPE(30), ESCAPE(31), ESCAPE(32),
+    ESCAPE('#'), ESCAPE('\\'),
 };
 
-static void append_with_normalization(string_t *string, char c)
+#undef ESCAPE
+
+/**
+ * Appends characters to the string literal being built
+ *
+ * The literal is written into context->literals pool (when there is one) or into context->string.
+ *
+ * @param context Pointer to context with required dependencies
+ * @param chars Characters to append
+ * @param n Number of characters
+ */
+static void append_literal(context_t *context, const char *chars, size_t n)
+{
+    int ret;
+
+    if (context->literals)
+        ret = strpool_appendn(context->literals, chars, n);
+    else
+        ret = string_appendn(context->string, chars, n);
+
+    if (ret < 0)
+        exit(EINTERNAL);
+}
+
+/**
+ * Appends character to the string literal being built in normalized form
+ *
+ * @param context Pointer to context with required dependencies
+ * @param c Character to append
+ */
+static void append_with_normalization(context_t *context, unsigned char c)
+{
+    if (escape_sequences[c][0])
+        append_literal(context, escape_sequences[c], 4);
+    else
+        append_literal(context, (const char *) &c, 1);
+}
+
+/**
+ * Adds digit to mantissa of numeric literal
+ *
+ * @param number Numeric literal being scanned
+ * @param digit Value of the digit
+ * @return Was the digit stored? (false means it didn't fit into mantissa)
+ */
+static bool add_mantissa_digit(struct number_literal *number, int digit)
 {
-    char tmp_char[5];
+    if (number->digits == NUMBER_MAX_DIGITS) {
+        number->truncated = true;
+        return false;
+    }
+
+    number->mantissa = number->mantissa * 10 + digit;
+    if (number->mantissa != 0)
+        number->digits++;
+
+    return true;
+}
 
-    if ((c >= 0 && c <= 32) || c == 35 || c == 92) {
-        // Normalize character into \ddd format (ddd = ASCII position)
-        sprintf(tmp_char, "\\%03d", c);
+/**
+ * Computes value of integer literal like (int) strtol(literal, NULL, 10) does
+ *
+ * @param number Scanned numeric literal
+ * @return Value of the literal
+ */
+static int integer_value(const struct number_literal *number)
+{
+    // strtol() saturates on overflow
+    if (number->truncated || number->mantissa > LONG_MAX)
+        return (int) LONG_MAX;
 
-        for (int i = 0; i < 4; i++) {
-            APPEND_C(string, tmp_char[i]);
+    return (int) (long) number->mantissa;
+}
+
+/**
+ * Computes value of number literal like strtod(literal, NULL) does
+ *
+ * When mantissa and the power of 10 are exactly representable, one multiplication
+ * or division gives correctly rounded result (Clinger's fast path). Other
+ * literals are converted by strtod() from input source.
+ *
+ * @param context Pointer to context with required dependencies
+ * @param number Scanned numeric literal
+ * @return Value of the literal
+ */
+static double number_value(context_t *context, const struct number_literal *number)
+{
+    source_t *src = context->scanner->source;
+    int exponent = number->scale + (number->exponent_negative ? -number->exponent : number->exponent);
+    uint64_t mantissa = number->mantissa;
+
+    if (NUMBER_FAST_PATH && !number->truncated && mantissa <= NUMBER_MAX_EXACT_MANTISSA) {
+        if (mantissa == 0)
+            return 0.0;
+
+        if (exponent < 0 && exponent >= -MAX_EXACT_POWER)
+            return (double) mantissa / exact_powers_of_10[-exponent];
+
+        // Part of bigger exponent can be moved into mantissa (if it stays exact)
+        while (exponent > MAX_EXACT_POWER && mantissa <= NUMBER_MAX_EXACT_MANTISSA / 10) {
+            mantissa *= 10;
+            exponent--;
         }
 
-        return;
+        if (exponent >= 0 && exponent <= MAX_EXACT_POWER)
+            return (double) mantissa * exact_powers_of_10[exponent];
     }
 
-    // Just append the char
-    APPEND_C(string, c);
+    // Literal is complete in input source, it just isn't null-terminated
+    string_clear(context->string);
+    if (string_appendn(context->string, src->data + number->start, src->pos - number->start) < 0)
+        exit(EINTERNAL);
+
+    return strtod(string_expose(context->string), NULL);
 }
 
-token_t get_next_token(context_t *context)
+/**
+ * Binds identifier token to the scope of symbols
+ *
+ * Identifier is searched in the most-local scope. If it isn't there, it's
+ * created in it with the position of the token.
+ *
+ * @param context Pointer to context with required dependencies
+ * @param atom Interned name of the identifier
+ * @param line Line of the token
+ * @param character Character (column) of the token's start
+ * @return Bound identifier
+ */
+static identifier_t *bind_identifier(context_t *context, const atom_t *atom, uint32_t line, uint32_t character)
 {
-    int c; // Loaded char from stdin
-    enum fsm_states state = S_INIT;
-    keyword_t *tmp_keyword;
     identifier_t *tmp_identifier;
-    symtable_t *tmp_symtable;
-    token_t token;
-    static int row = 1; // X coord of input
-    static int column = 1; // Y coord of input
 
-    // Prepare string factory
-    string_clear(context->string);
+    // Try to find identifier in the most-local scope
+    tmp_identifier = symstack_find_local(context->symstack, atom);
+    if (!tmp_identifier) {
+        // Create new identifier in the most-local scope
+        tmp_identifier = symstack_add_local(context->symstack, atom);
+        if (!tmp_identifier)
+            exit(EINTERNAL);
+
+        // Setup new identifier
+        tmp_identifier->line = line;
+        tmp_identifier->character = character;
+    }
+
+    return tmp_identifier;
+}
+
+/**
+ * Finishes the string literal being built
+ *
+ * @param context Pointer to context with required dependencies
+ * @return Normalized string literal (in context->literals pool or allocated)
+ */
+static char *finish_string_literal(context_t *context)
+{
+    char *string;
+
+    if (context->literals)
+        string = strpool_finish(context->literals);
+    else
+        string = string_export(context->string);
+
+    if (!string)
+        exit(EINTERNAL);
+
+    return string;
+}
+
+/**
+ * Token types of accepting states with simple tokens (without any value)
+ */
+static const enum token_type simple_token_types[S_ACCEPT] = {
+    [S_DIV] = DIVISION,
+    [S_INT_DIV] = INT_DIVISION,
+    [S_PLUS] = ADDITION,
+    [S_MUL] = MULTIPLICATION,
+    [S_GT] = GT,
+    [S_GE] = GEQ,
+    [S_LT] = LT,
+    [S_LE] = LEQ,
+    [S_ASSIGN] = ASSIGNMENT,
+    [S_EQ] = EQ,
+    [S_TYPE_SPEC] = TYPE_SPEC,
+    [S_COMMA] = COMMA,
+    [S_STRLEN] = STRLEN,
+    [S_LEFT_PAR] = LEFT_PAR,
+    [S_RIGHT_PAR] = RIGHT_PAR,
+    [S_MINUS] = SUBTRACTION,
+    [S_CAT_2] = CONCAT,
+    [S_NE_2] = NEQ,
+};
+
+/**
+ * Creates token from the loaded lexeme
+ *
+ * @param context Pointer to context with required dependencies
+ * @param state Accepting state FSM is in
+ * @param row Row of the input the token ends at
+ * @param column Column of the input the token ends at (the next character's one)
+ * @param number Numeric literal (it's valid only in states of numeric literals)
+ * @return Complete token
+ */
+static token_t accept_token(context_t *context, enum fsm_states state, int row, int column,
+                            const struct number_literal *number)
+{
+    keyword_t *tmp_keyword;
+    const atom_t *atom;
+    token_t token = {0};
+
+    switch (state) {
+        case S_SYMBOL:
+            // We have complete symbol, but we don't know what is it - keyword or identifier?
+            tmp_keyword = kwtable_find_n(context->kwtable, string_expose(context->string), context->string->len);
+            if (tmp_keyword) {
+                token.type = KEYWORD;
+                token.keyword = tmp_keyword;
+
+                return token;
+            }
 
-    // Just return saved token, when there is one
-    if (!token_cache_empty) {
-        token_cache_empty = true;
+            // Name is hashed only once here, tables of symbols use the interned atom
+            atom = interner_intern(context->interner, string_expose(context->string), context->string->len);
+            if (!atom)
+                exit(EINTERNAL);
 
-        return saved_token;
+            token.type = IDENTIFIER;
+            token.identifier = bind_identifier(context, atom, row, column - atom->len);
+
+            return token;
+        case S_INT:
+            token.type = INTEGER;
+            token.integer = integer_value(number);
+
+            return token;
+        case S_NUM:
+        case S_NUM_EXP:
+            token.type = NUMBER;
+            token.number = number_value(context, number);
+
+            return token;
+        case S_STR_OUT:
+            token.type = STRING;
+            token.string = finish_string_literal(context);
+
+            return token;
+        default:
+            return INIT_TOKEN(token, simple_token_types[state]);
     }
+}
+
+/**
+ * Constructs next token from data in input source
+ *
+ * @param context Pointer to context with required dependencies
+ * @return Parsed input encapsulated into token
+ */
+static token_t lex_token(context_t *context)
+{
+    int c; // Loaded char from input source
+    scanner_t *scanner = context->scanner;
+    source_t *src = scanner->source;
+    enum fsm_states state = S_INIT;
+    unsigned short transition;
+    size_t run_start; // Start of the skipped run of characters
+    size_t run_len; // Length of the skipped run of characters
+    struct number_literal number = {0}; // Numeric literal being converted
+    token_t token;
+    int row = scanner->row; // X coord of input
+    int column = scanner->column; // Y coord of input
 
-    // Construct token from data on standard input
-    c = getchar();
+    // Prepare string factory (and literals pool)
+    string_clear(context->string);
+    if (context->literals)
+        strpool_discard(context->literals);
+
+    // Construct token from data in input source
+    c = GET_CHAR(src);
     while (c != EOF) {
-        // We're using states from enum, default isn't needed
-        switch (state) { // NOLINT(hicpp-multiway-paths-covered)
-            case S_INIT:
-                if (isspace(c)) {
-                    if (c == '\n') {
-                        NEW_ROW(row, column);
-                    }
-
-                    state = S_INIT;
-                }
-                else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
-                    APPEND_C(context->string, c);
-                    state = S_SYMBOL;
-                } else if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_INT;
-                } else if (c == '/')
-                    state = S_DIV;
-                else if (c == '+')
-                    state = S_PLUS;
-                else if (c == '*')
-                    state = S_MUL;
-                else if (c == '>')
-                    state = S_GT;
-                else if (c == '<')
-                    state = S_LT;
-                else if (c == '=')
-                    state = S_ASSIGN;
-                else if (c == ':')
-                    state = S_TYPE_SPEC;
-                else if (c == ',')
-                    state = S_COMMA;
-                else if (c == '#')
-                    state = S_STRLEN;
-                else if (c == '(')
-                    state = S_LEFT_PAR;
-                else if (c == ')')
-                    state = S_RIGHT_PAR;
-                else if (c == '-')
-                    state = S_MINUS;
-                else if (c == '"')
-                    state = S_STR_IN;
-                else if (c == '.')
-                    state = S_CAT_1;
-                else if (c == '~')
-                    state = S_NE_1;
-                else
-                    exit(ELEX);
-                break;
-            case S_SYMBOL:
-                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_SYMBOL;
-                } else {
-                    // We have complete symbol, but we don't know what is it - keyword or identifier?
-                    tmp_keyword = kwtable_find(context->kwtable, string_expose(context->string));
-                    if (tmp_keyword) {
-                        token.type = KEYWORD;
-                        token.keyword = tmp_keyword;
-                    } else {
-                        // Try to find identifier in tables of symbols
-                        symstack_most_local(context->symstack);
-                        tmp_identifier = symtable_find(symstack_get(context->symstack), string_expose(context->string));
-                        if (!tmp_identifier) {
-                            // Create new identifier in the most-local symtable
-                            symstack_most_local(context->symstack);
-                            tmp_symtable = symstack_get(context->symstack);
-                            tmp_identifier = symtable_add(tmp_symtable, string_expose(context->string));
-
-                            // Setup new identifier
-                            tmp_identifier->line = row;
-                            tmp_identifier->character = column - strlen(string_expose(context->string));
-                        }
-
-                        token.type = IDENTIFIER;
-                        token.identifier = tmp_identifier;
-                    }
-
-                    UNGET_CHAR(c);
-                    return token;
-                }
+        transition = fsm_transitions[state][fsm_char_classes[c]];
+
+        if (FSM_NEXT(transition) == S_ACCEPT) {
+            // Loaded character belongs to the next token
+            UNGET_CHAR(src);
+            scanner->row = row;
+            scanner->column = column;
+
+            return accept_token(context, state, row, column, &number);
+        } else if (FSM_NEXT(transition) == S_ERROR) {
+            if (state == S_STR_IN)
+                LOG_ERROR_M("Invalid string literal. Missing closing quotes!");
+
+            exit(ELEX);
+        }
+
+        switch (FSM_ACTION(transition)) {
+            case A_NONE:
                 break;
-            case S_INT:
+            case A_APPEND:
                 APPEND_C(context->string, c);
-
-                if (isdigit(c))
-                    state = S_INT;
-                else if (c == '.')
-                    state = S_DEC;
-                else if (c == 'e' || c == 'E')
-                    state = S_EXP;
-                else {
-                    token.type = INTEGER;
-                    token.integer = (int)strtol(string_expose(context->string), NULL, 10);
-
-                    UNGET_CHAR(c);
-                    return token;
-                }
                 break;
-            case S_DEC:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_NUM;
-                } else
-                    exit(ELEX);
+            case A_NEW_ROW:
+                NEW_ROW(row, column);
                 break;
-            case S_NUM:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_NUM;
-                } else if (c == 'e' || c == 'E') {
-                    APPEND_C(context->string, c);
-                    state = S_EXP;
-                } else {
-                    token.type = NUMBER;
-                    token.number = strtod(string_expose(context->string), NULL);
-
-                    UNGET_CHAR(c);
-                    return token;
-                }
+            case A_NORMALIZE:
+                append_with_normalization(context, (unsigned char) c);
                 break;
-            case S_EXP:
-                if (c == '+' || c == '-') {
-                    APPEND_C(context->string, c);
-                    state = S_EXP_SIGN;
-                } else if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_NUM_EXP;
-                } else
-                    exit(ELEX);
+            case A_ESC_EOL:
+                append_with_normalization(context, '\n');
                 break;
-            case S_EXP_SIGN:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_NUM_EXP;
-                } else
-                    exit(ELEX);
+            case A_ESC_TAB:
+                append_with_normalization(context, '\t');
                 break;
-            case S_NUM_EXP:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_NUM_EXP;
-                } else {
-                    token.type = NUMBER;
-                    token.number = strtod(string_expose(context->string), NULL);
-
-                    UNGET_CHAR(c);
-                    return token;
-                }
+            case A_ESC_DIGIT:
+                // Backslash is ignored in other cases, so it needs to be explicitly appended here
+                append_literal(context, "\\", 1);
+                append_literal(context, (const char *) &src->data[src->pos - 1], 1);
                 break;
-            case S_DIV:
-                if (c == '/')
-                    state = S_INT_DIV;
-                else {
-                    UNGET_CHAR(c);
-                    return INIT_TOKEN(token, DIVISION);
-                }
+            case A_STR_APPEND:
+                append_literal(context, (const char *) &src->data[src->pos - 1], 1);
                 break;
-            case S_INT_DIV:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, INT_DIVISION);
-            case S_PLUS:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, ADDITION);
-            case S_MUL:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, MULTIPLICATION);
-            case S_GT:
-                if (c == '=')
-                    state = S_GE;
-                else {
-                    UNGET_CHAR(c);
-                    return INIT_TOKEN(token, GT);
-                }
+            case A_NUM_START:
+                number = (struct number_literal) {.start = src->pos - 1};
+                add_mantissa_digit(&number, c - '0');
                 break;
-            case S_GE:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, GEQ);
-            case S_LT:
-                if (c == '=')
-                    state = S_LE;
-                else {
-                    UNGET_CHAR(c);
-                    return INIT_TOKEN(token, LT);
-                }
+            case A_INT_DIGIT:
+                add_mantissa_digit(&number, c - '0');
                 break;
-            case S_LE:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, LEQ);
-            case S_ASSIGN:
-                if (c == '=')
-                    state = S_EQ;
-                else {
-                    UNGET_CHAR(c);
-                    return INIT_TOKEN(token, ASSIGNMENT);
-                }
+            case A_FRAC_DIGIT:
+                if (add_mantissa_digit(&number, c - '0'))
+                    number.scale--;
                 break;
-            case S_EQ:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, EQ);
-            case S_TYPE_SPEC:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, TYPE_SPEC);
-            case S_COMMA:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, COMMA);
-            case S_STRLEN:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, STRLEN);
-            case S_LEFT_PAR:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, LEFT_PAR);
-            case S_RIGHT_PAR:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, RIGHT_PAR);
-            case S_MINUS:
-                if (c == '-')
-                    state = S_DECIDE_COMM;
-                else {
-                    UNGET_CHAR(c);
-                    return INIT_TOKEN(token, SUBTRACTION);
-                }
+            case A_EXP_SIGN:
+                number.exponent_negative = c == '-';
                 break;
-            case S_DECIDE_COMM:
-                if (c == '[')
-                    state = S_ML_COMM_1;
-                else
-                    state = S_LINE_COMM;
+            case A_EXP_DIGIT:
+                if (number.exponent < NUMBER_MAX_EXPONENT)
+                    number.exponent = number.exponent * 10 + (c - '0');
                 break;
-            case S_LINE_COMM:
-                if (c == '\n') {
-                    state = S_INIT;
+        }
 
-                    NEW_ROW(row, column);
-                }
-                else
-                    state = S_LINE_COMM;
-                break;
-            case S_ML_COMM_1:
-                if (c == '[')
-                    state = S_ML_COMM_2;
-                else
-                    state = S_LINE_COMM;
+        state = FSM_NEXT(transition);
+
+        // Jump over runs of characters, which don't change the state (EOLs always stop skipping, so rows stay right)
+        switch (state) {
+            case S_LINE_COMM:
+                column += source_skip(src, SKIP_TO_EOL);
                 break;
             case S_ML_COMM_2:
-                if (c == ']')
-                    state = S_ML_COMM_3;
-                else {
-                    if (c == '\n')
-                        NEW_ROW(row, column);
-
-                    state = S_ML_COMM_2;
-                }
-                break;
-            case S_ML_COMM_3:
-                if (c == ']')
-                    state = S_INIT;
-                else
-                    state = S_ML_COMM_2;
+                column += source_skip(src, SKIP_TO_EOL_OR_RBRACKET);
                 break;
             case S_STR_IN:
-                if (c == '"')
-                    state = S_STR_OUT;
-                else if (c == '\n') {
-                    LOG_ERROR_M("Invalid string literal. Missing closing quotes!");
-                    exit(ELEX);
-                }
-                else if (c == '\\')
-                    state = S_ESCAPE;
-                else {
-                    append_with_normalization(context->string, (char) c);
-                    state = S_STR_IN;
-                }
-                break;
-            case S_STR_OUT:
-                token.type = STRING;
-                token.string = string_export(context->string);
+                run_start = src->pos;
+                run_len = source_skip(src, SKIP_TO_STRING_SPECIAL);
+                append_literal(context, src->data + run_start, run_len);
 
-                UNGET_CHAR(c);
-                return token;
-            case S_ESCAPE:
-                if (isdigit(c)) {
-                    // Backslash is ignored in other cases, so it needs to be explicitly appended here
-                    APPEND_C(context->string, '\\');
-                    APPEND_C(context->string, c);
-                    state = S_ESCAPE_D;
-                } else if (c == '"' || c == '\\' || c == 'n' || c == 't') {
-                    if (c == 'n')
-                        append_with_normalization(context->string, '\n');
-                    else if (c == 't')
-                        append_with_normalization(context->string, '\t');
-                    else
-                        append_with_normalization(context->string, (char) c);
-
-                    state = S_STR_IN;
-                } else
-                    exit(ELEX);
-                break;
-            case S_ESCAPE_D:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_ESCAPE_DD;
-                } else
-                    exit(ELEX);
+                column += run_len;
                 break;
-            case S_ESCAPE_DD:
-                if (isdigit(c)) {
-                    APPEND_C(context->string, c);
-                    state = S_STR_IN;
-                } else
-                    exit(ELEX);
+            default:
                 break;
-            case S_CAT_1:
-                if (c == '.')
-                    state = S_CAT_2;
-                else
-                    exit(ELEX);
-                break;
-            case S_CAT_2:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, CONCAT);
-            case S_NE_1:
-                if (c == '=')
-                    state = S_NE_2;
-                else
-                    exit(ELEX);
-                break;
-            case S_NE_2:
-                UNGET_CHAR(c);
-                return INIT_TOKEN(token, NEQ);
         }
 
         // Load next character
-        c = getchar();
+        c = GET_CHAR(src);
         column++;
     }
 
-    // c == EOF --> we're at the end of input stream
+    // c == EOF --> we're at the end of input source
+    scanner->row = row;
+    scanner->column = column;
     token.type = END;
 
     return token;
 }
 
-void unget_token(token_t token)
+/**
+ * Adds token to scanner's token cache
+ *
+ * @param context Pointer to context with required dependencies
+ * @param token Token returned by lex_token()
+ */
+static void record_token(context_t *context, token_t token)
+{
+    scanner_t *scanner = context->scanner;
+    tokcache_token_t cached = {.type = token.type};
+
+    switch (token.type) {
+        case KEYWORD:
+            cached.keyword = *token.keyword;
+            break;
+        case IDENTIFIER:
+            // Position of this occurrence (the identifier keeps the position of the first one)
+            cached.identifier.atom = token.identifier->atom;
+            cached.identifier.line = scanner->row;
+            cached.identifier.character = scanner->column - token.identifier->atom->len;
+            break;
+        case INTEGER:
+            cached.integer = token.integer;
+            break;
+        case NUMBER:
+            cached.number = token.number;
+            break;
+        case STRING:
+            cached.string.chars = token.string;
+            cached.string.len = strlen(token.string);
+            break;
+        default:
+            break;
+    }
+
+    if (tokcache_writer_add(scanner->cache_writer, &cached) < 0)
+        exit(EINTERNAL);
+}
+
+/**
+ * Loads next token from scanner's token cache
+ *
+ * Identifiers are bound to tables of symbols and string literals are stored
+ * the same way as when they're scanned.
+ *
+ * @param context Pointer to context with required dependencies
+ * @return Token from the cache
+ */
+static token_t replay_token(context_t *context)
 {
-    if (!token_cache_empty) {
-        // Token cache is one-item only, we can't store more tokens
-        LOG_ERROR_M("Tried to unget second token to scanner. This operation is forbidden.");
+    tokcache_token_t cached;
+    token_t token;
+
+    if (tokcache_reader_next(context->scanner->cache_reader, &cached) < 0) {
+        LOG_ERROR_M("Token cache is corrupted!");
+        exit(EINTERNAL);
+    }
+
+    token.type = cached.type;
+    switch (cached.type) {
+        case KEYWORD:
+            token.keyword = &((*context->kwtable)[cached.keyword]);
+            break;
+        case IDENTIFIER:
+            token.identifier = bind_identifier(context, cached.identifier.atom, cached.identifier.line,
+                                               cached.identifier.character);
+            break;
+        case INTEGER:
+            token.integer = cached.integer;
+            break;
+        case NUMBER:
+            token.number = cached.number;
+            break;
+        case STRING:
+            string_clear(context->string);
+            if (context->literals)
+                strpool_discard(context->literals);
+
+            append_literal(context, cached.string.chars, cached.string.len);
+            token.string = finish_string_literal(context);
+            break;
+        default:
+            break;
+    }
+
+    return token;
+}
+
+/**
+ * Obtains next token from scanner's input (token cache or input source)
+ *
+ * @param context Pointer to context with required dependencies
+ * @return Next token
+ */
+static token_t scan_token(context_t *context)
+{
+    scanner_t *scanner = context->scanner;
+    token_t token;
+
+    if (scanner->cache_reader)
+        return replay_token(context);
+
+    token = lex_token(context);
+    if (scanner->cache_writer)
+        record_token(context, token);
+
+    return token;
+}
+
+scanner_t *scanner_create(source_t *source)
+{
+    assert(source);
+
+    scanner_t *scanner = malloc(sizeof(scanner_t));
+    if (!scanner)
+        return NULL;
+
+    scanner->source = source;
+    scanner->row = 1;
+    scanner->column = 1;
+    scanner->lookahead_start = 0;
+    scanner->lookahead_count = 0;
+    scanner->cache_reader = NULL;
+    scanner->cache_writer = NULL;
+
+    return scanner;
+}
+
+void scanner_destroy(scanner_t *scanner)
+{
+    assert(scanner);
+
+    if (scanner->cache_reader)
+        tokcache_reader_destroy(scanner->cache_reader);
+    if (scanner->cache_writer)
+        tokcache_writer_destroy(scanner->cache_writer);
+
+    source_destroy(scanner->source);
+    free(scanner);
+}
+
+token_t get_next_token(context_t *context)
+{
+    scanner_t *scanner = context->scanner;
+    token_t token;
+
+    // Tokens loaded ahead go first
+    if (scanner->lookahead_count > 0) {
+        token = scanner->lookahead[scanner->lookahead_start];
+        scanner->lookahead_start = (scanner->lookahead_start + 1) % LOOKAHEAD_SIZE;
+        scanner->lookahead_count--;
+
+        return token;
+    }
+
+    return scan_token(context);
+}
+
+token_t peek_token(context_t *context, int k)
+{
+    assert(k >= 0 && k < LOOKAHEAD_SIZE);
+
+    scanner_t *scanner = context->scanner;
+
+    // Load missing tokens to the end of lookahead buffer
+    while (scanner->lookahead_count <= k) {
+        scanner->lookahead[(scanner->lookahead_start + scanner->lookahead_count) % LOOKAHEAD_SIZE] =
+                scan_token(context);
+        scanner->lookahead_count++;
+    }
+
+    return scanner->lookahead[(scanner->lookahead_start + k) % LOOKAHEAD_SIZE];
+}
+
+void unget_token(context_t *context, token_t token)
+{
+    scanner_t *scanner = context->scanner;
+
+    if (scanner->lookahead_count == LOOKAHEAD_SIZE) {
+        // Lookahead buffer is full, we can't store more tokens
+        LOG_ERROR("Tried to unget more than %d tokens to scanner. This operation is forbidden.", LOOKAHEAD_SIZE);
         return;
     }
 
-    saved_token = token;
-    token_cache_empty = false;
+    // Returned token will be the nearest one
+    scanner->lookahead_start = (scanner->lookahead_start + LOOKAHEAD_SIZE - 1) % LOOKAHEAD_SIZE;
+    scanner->lookahead[scanner->lookahead_start] = token;
+    scanner->lookahead_count++;
 }
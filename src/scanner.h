@@ -2,7 +2,7 @@
  * @file scanner.h
  * Header file of scanner (lexical analyzer)
  *
- * Scanner loads code from stdin and parses it into tokens for syntactic analyzer
+ * Scanner loads code from input source and parses it into tokens for syntactic analyzer
  *
  * IFJ and IAL project (IFJ21 compiler)
  * Team: 128 (variant II)
@@ -16,16 +16,55 @@
 #include "token.h"
 #include "symstack.h"
 #include "context.h"
+#include "source.h"
+#include "tokcache.h"
 
 #include <stdbool.h>
 #include <stdlib.h>
 
 /**
- * Puts character back to standard input stream
+ * Maximal number of tokens loaded ahead (by peek_token() and unget_token())
+ */
+#define LOOKAHEAD_SIZE 8
+
+/**
+ * Scanner state (everything it needs to know between two tokens)
  *
- * It doesn't put back whitespace characters except EOL
+ * Content:
+ * <ul>
+ *      <li><code>source</code> - Input source the scanner reads from (owned by the scanner)</li>
+ *      <li><code>row</code> - Row of the next character in input</li>
+ *      <li><code>column</code> - Column of the next character in input</li>
+ *      <li><code>lookahead</code> - Ring buffer of tokens loaded ahead (peeked or returned to scanner)</li>
+ *      <li><code>lookahead_start</code> - Index of the first (the nearest) token in lookahead buffer</li>
+ *      <li><code>lookahead_count</code> - Number of tokens in lookahead buffer</li>
+ *      <li><code>cache_reader</code> - Token cache tokens are read from instead of scanning
+ *          the source (optional, owned by the scanner)</li>
+ *      <li><code>cache_writer</code> - Token cache scanned tokens are written to (optional, owned
+ *          by the scanner)</li>
+ * </ul>
+ */
+typedef struct scanner {
+    source_t *source;
+    int row;
+    int column;
+    token_t lookahead[LOOKAHEAD_SIZE];
+    int lookahead_start;
+    int lookahead_count;
+    tokcache_reader_t *cache_reader;
+    tokcache_writer_t *cache_writer;
+} scanner_t;
+
+/**
+ * Loads next character from input source
  */
-#define UNGET_CHAR(c) ungetc(c, stdin)
+#define GET_CHAR(src) SOURCE_GETC(src)
+/**
+ * Puts the last loaded character back to input source
+ *
+ * It's just a cursor decrement, the source is already loaded in memory
+ */
+#define UNGET_CHAR(src) SOURCE_UNGETC(src)
 /**
  * Calls string_append() function with error handling
  */
@@ -40,7 +79,33 @@
 #define NEW_ROW(row, col) do { (row)++; col = 0; } while(0)
 
 /**
- * Obtains next token from standard input
+ * Creates a new scanner reading from the source
+ *
+ * Scanner takes over the source, so it's destroyed with the scanner.
+ *
+ * Scanner reads tokens from the source, token cache can be set up later
+ * (see cache_reader and cache_writer).
+ *
+ * @param source Input source with the program to scan
+ * @return Pointer to the new scanner or NULL if error occurred
+ *
+ * @pre source != NULL
+ */
+scanner_t *scanner_create(source_t *source);
+
+/**
+ * Destroys scanner, its input source and token caches
+ *
+ * @param scanner Scanner to destroy
+ *
+ * @pre scanner != NULL
+ */
+void scanner_destroy(scanner_t *scanner);
+
+/**
+ * Obtains next token from input source (context->scanner)
+ *
+ * Tokens loaded ahead (see peek_token() and unget_token()) are returned first.
  *
  * @param context Pointer to context with required dependencies
  * @return Parsed input encapsulated into token
@@ -48,15 +113,32 @@
 token_t get_next_token(context_t *context);
 
 /**
- * Saves token to one-item cache
+ * Looks at the token k positions ahead without consuming it
  *
- * This function provides functionality for "returning tokens to scanner".
- * Scanner saves the token into built-in cache and returns it at the
- * next calling of get_next_token() function. The cache is one-item only,
- * so you can put off just one token this way.
+ * peek_token(context, 0) returns the token the next get_next_token() call
+ * returns, peek_token(context, 1) the one after it etc. Peeked tokens are
+ * stored in the lookahead buffer. Identifiers are bound to the tables of
+ * symbols when they're loaded (peeked), not when they're consumed.
  *
+ * @param context Pointer to context with required dependencies
+ * @param k Position of the token (0 = the nearest one)
+ * @return Token at the required position
+ *
+ * @pre 0 <= k < LOOKAHEAD_SIZE
+ */
+token_t peek_token(context_t *context, int k);
+
+/**
+ * Returns token to scanner
+ *
+ * Scanner saves the token in front of the lookahead buffer and returns it
+ * at the next calling of get_next_token() function. Tokens are returned
+ * in reversed order of ungetting. There can be up to LOOKAHEAD_SIZE
+ * tokens (incl. peeked ones) in the buffer.
+ *
+ * @param context Pointer to context with required dependencies
  * @param token Token to be saved
  */
-void unget_token(token_t token);
+void unget_token(context_t *context, token_t token);
 
 #endif //_SCANNER_H_
@@ -0,0 +1,798 @@
+/**
+ * @file scanner_fsm.h
+ * Transition table of scanner's finite state machine
+ *
+ * GENERATED FILE, DON'T EDIT IT MANUALLY!
+ * Source: design/scanner_fsm.txt, generator: src/gen-scanner-fsm.sh
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _SCANNER_FSM_H_
+#define _SCANNER_FSM_H_
+
+/**
+ * Packs the next state and the action into one transition table's item
+ */
+#define FSM_T(next, action) ((unsigned short) ((action) << 8 | (next)))
+/**
+ * Extracts the next state from the transition table's item
+ */
+#define FSM_NEXT(transition) ((transition) & 0xff)
+/**
+ * Extracts the action from the transition table's item
+ */
+#define FSM_ACTION(transition) ((transition) >> 8)
+
+/**
+ * Finite state machine's states
+ *
+ * S_ACCEPT and S_ERROR are pseudo-states (they don't have rows in transition table)
+ */
+enum fsm_states {
+    S_INIT,
+    S_SYMBOL,
+    S_INT,
+    S_DEC,
+    S_NUM,
+    S_EXP,
+    S_EXP_SIGN,
+    S_NUM_EXP,
+    S_DIV,
+    S_INT_DIV,
+    S_PLUS,
+    S_MUL,
+    S_GT,
+    S_GE,
+    S_LT,
+    S_LE,
+    S_ASSIGN,
+    S_EQ,
+    S_TYPE_SPEC,
+    S_COMMA,
+    S_STRLEN,
+    S_LEFT_PAR,
+    S_RIGHT_PAR,
+    S_CAT_1,
+    S_CAT_2,
+    S_NE_1,
+    S_NE_2,
+    S_MINUS,
+    S_DECIDE_COMM,
+    S_LINE_COMM,
+    S_ML_COMM_1,
+    S_ML_COMM_2,
+    S_ML_COMM_3,
+    S_STR_IN,
+    S_STR_OUT,
+    S_ESCAPE,
+    S_ESCAPE_D,
+    S_ESCAPE_DD,
+    S_ACCEPT, S_ERROR
+};
+
+/**
+ * Actions done when transition is used
+ */
+enum fsm_actions {
+    A_NONE,
+    A_NEW_ROW,
+    A_APPEND,
+    A_NUM_START,
+    A_INT_DIGIT,
+    A_FRAC_DIGIT,
+    A_EXP_SIGN,
+    A_EXP_DIGIT,
+    A_NORMALIZE,
+    A_ESC_DIGIT,
+    A_ESC_EOL,
+    A_ESC_TAB,
+    A_STR_APPEND
+};
+
+/**
+ * Classes of input characters (characters with the same transitions)
+ */
+enum char_class {
+    CC_OTHER,
+    CC_LETTER,
+    CC_E,
+    CC_N,
+    CC_T,
+    CC_DIGIT,
+    CC_EOL,
+    CC_SPACE,
+    CC_SLASH,
+    CC_PLUS,
+    CC_STAR,
+    CC_GT,
+    CC_LT,
+    CC_ASSIGN,
+    CC_COLON,
+    CC_COMMA,
+    CC_HASH,
+    CC_LPAR,
+    CC_RPAR,
+    CC_MINUS,
+    CC_QUOTE,
+    CC_DOT,
+    CC_TILDE,
+    CC_LBRACKET,
+    CC_RBRACKET,
+    CC_BACKSLASH,
+    CC_COUNT
+};
+
+/**
+ * Map of characters to their classes
+ */
+static const unsigned char fsm_char_classes[256] = {
+    [9] = CC_SPACE,
+    [10] = CC_EOL,
+    [11] = CC_SPACE,
+    [12] = CC_SPACE,
+    [13] = CC_SPACE,
+    [32] = CC_SPACE,
+    [34] = CC_QUOTE, // "
+    [35] = CC_HASH, // #
+    [40] = CC_LPAR, // (
+    [41] = CC_RPAR, // )
+    [42] = CC_STAR, // *
+    [43] = CC_PLUS, // +
+    [44] = CC_COMMA, // ,
+    [45] = CC_MINUS, // -
+    [46] = CC_DOT, // .
+    [47] = CC_SLASH, // /
+    [48] = CC_DIGIT, // 0
+    [49] = CC_DIGIT, // 1
+    [50] = CC_DIGIT, // 2
+    [51] = CC_DIGIT, // 3
+    [52] = CC_DIGIT, // 4
+    [53] = CC_DIGIT, // 5
+    [54] = CC_DIGIT, // 6
+    [55] = CC_DIGIT, // 7
+    [56] = CC_DIGIT, // 8
+    [57] = CC_DIGIT, // 9
+    [58] = CC_COLON, // :
+    [60] = CC_LT, // <
+    [61] = CC_ASSIGN, // =
+    [62] = CC_GT, // >
+    [65] = CC_LETTER, // A
+    [66] = CC_LETTER, // B
+    [67] = CC_LETTER, // C
+    [68] = CC_LETTER, // D
+    [69] = CC_E, // E
+    [70] = CC_LETTER, // F
+    [71] = CC_LETTER, // G
+    [72] = CC_LETTER, // H
+    [73] = CC_LETTER, // I
+    [74] = CC_LETTER, // J
+    [75] = CC_LETTER, // K
+    [76] = CC_LETTER, // L
+    [77] = CC_LETTER, // M
+    [78] = CC_LETTER, // N
+    [79] = CC_LETTER, // O
+    [80] = CC_LETTER, // P
+    [81] = CC_LETTER, // Q
+    [82] = CC_LETTER, // R
+    [83] = CC_LETTER, // S
+    [84] = CC_LETTER, // T
+    [85] = CC_LETTER, // U
+    [86] = CC_LETTER, // V
+    [87] = CC_LETTER, // W
+    [88] = CC_LETTER, // X
+    [89] = CC_LETTER, // Y
+    [90] = CC_LETTER, // Z
+    [91] = CC_LBRACKET, // [
+    [92] = CC_BACKSLASH,
+    [93] = CC_RBRACKET, // ]
+    [95] = CC_LETTER, // _
+    [97] = CC_LETTER, // a
+    [98] = CC_LETTER, // b
+    [99] = CC_LETTER, // c
+    [100] = CC_LETTER, // d
+    [101] = CC_E, // e
+    [102] = CC_LETTER, // f
+    [103] = CC_LETTER, // g
+    [104] = CC_LETTER, // h
+    [105] = CC_LETTER, // i
+    [106] = CC_LETTER, // j
+    [107] = CC_LETTER, // k
+    [108] = CC_LETTER, // l
+    [109] = CC_LETTER, // m
+    [110] = CC_N, // n
+    [111] = CC_LETTER, // o
+    [112] = CC_LETTER, // p
+    [113] = CC_LETTER, // q
+    [114] = CC_LETTER, // r
+    [115] = CC_LETTER, // s
+    [116] = CC_T, // t
+    [117] = CC_LETTER, // u
+    [118] = CC_LETTER, // v
+    [119] = CC_LETTER, // w
+    [120] = CC_LETTER, // x
+    [121] = CC_LETTER, // y
+    [122] = CC_LETTER, // z
+    [126] = CC_TILDE, // ~
+};
+
+/**
+ * Transition table (state x character class --> FSM_T(next state, action))
+ */
+static const unsigned short fsm_transitions[S_ACCEPT][CC_COUNT] = {
+    [S_INIT] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_SYMBOL, A_APPEND),
+        [CC_E] = FSM_T(S_SYMBOL, A_APPEND), [CC_N] = FSM_T(S_SYMBOL, A_APPEND),
+        [CC_T] = FSM_T(S_SYMBOL, A_APPEND), [CC_DIGIT] = FSM_T(S_INT, A_NUM_START),
+        [CC_EOL] = FSM_T(S_INIT, A_NEW_ROW), [CC_SPACE] = FSM_T(S_INIT, A_NONE),
+        [CC_SLASH] = FSM_T(S_DIV, A_NONE), [CC_PLUS] = FSM_T(S_PLUS, A_NONE),
+        [CC_STAR] = FSM_T(S_MUL, A_NONE), [CC_GT] = FSM_T(S_GT, A_NONE),
+        [CC_LT] = FSM_T(S_LT, A_NONE), [CC_ASSIGN] = FSM_T(S_ASSIGN, A_NONE),
+        [CC_COLON] = FSM_T(S_TYPE_SPEC, A_NONE), [CC_COMMA] = FSM_T(S_COMMA, A_NONE),
+        [CC_HASH] = FSM_T(S_STRLEN, A_NONE), [CC_LPAR] = FSM_T(S_LEFT_PAR, A_NONE),
+        [CC_RPAR] = FSM_T(S_RIGHT_PAR, A_NONE), [CC_MINUS] = FSM_T(S_MINUS, A_NONE),
+        [CC_QUOTE] = FSM_T(S_STR_IN, A_NONE), [CC_DOT] = FSM_T(S_CAT_1, A_NONE),
+        [CC_TILDE] = FSM_T(S_NE_1, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_SYMBOL] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_SYMBOL, A_APPEND),
+        [CC_E] = FSM_T(S_SYMBOL, A_APPEND), [CC_N] = FSM_T(S_SYMBOL, A_APPEND),
+        [CC_T] = FSM_T(S_SYMBOL, A_APPEND), [CC_DIGIT] = FSM_T(S_SYMBOL, A_APPEND),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_INT] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_EXP, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_INT, A_INT_DIGIT),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_DEC, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_DEC] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_NUM, A_FRAC_DIGIT),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_NUM] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_EXP, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_NUM, A_FRAC_DIGIT),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_EXP] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_NUM_EXP, A_EXP_DIGIT),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_EXP_SIGN, A_EXP_SIGN),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_EXP_SIGN, A_EXP_SIGN),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_EXP_SIGN] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_NUM_EXP, A_EXP_DIGIT),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_NUM_EXP] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_NUM_EXP, A_EXP_DIGIT),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_DIV] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_INT_DIV, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_INT_DIV] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_PLUS] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_MUL] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_GT] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_GE, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_GE] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_LT] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_LE, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_LE] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_ASSIGN] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_EQ, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_EQ] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_TYPE_SPEC] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_COMMA] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_STRLEN] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_LEFT_PAR] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_RIGHT_PAR] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_CAT_1] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_ERROR, A_NONE),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_CAT_2, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_CAT_2] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_NE_1] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_ERROR, A_NONE),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_NE_2, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_NE_2] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_MINUS] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_DECIDE_COMM, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_DECIDE_COMM] = {
+        [CC_OTHER] = FSM_T(S_LINE_COMM, A_NONE), [CC_LETTER] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_E] = FSM_T(S_LINE_COMM, A_NONE), [CC_N] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_T] = FSM_T(S_LINE_COMM, A_NONE), [CC_DIGIT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_EOL] = FSM_T(S_LINE_COMM, A_NONE), [CC_SPACE] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_SLASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_PLUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_STAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_GT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_LT] = FSM_T(S_LINE_COMM, A_NONE), [CC_ASSIGN] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_COLON] = FSM_T(S_LINE_COMM, A_NONE), [CC_COMMA] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_HASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_LPAR] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_RPAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_MINUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_QUOTE] = FSM_T(S_LINE_COMM, A_NONE), [CC_DOT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_TILDE] = FSM_T(S_LINE_COMM, A_NONE), [CC_LBRACKET] = FSM_T(S_ML_COMM_1, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_LINE_COMM, A_NONE), [CC_BACKSLASH] = FSM_T(S_LINE_COMM, A_NONE),
+    },
+    [S_LINE_COMM] = {
+        [CC_OTHER] = FSM_T(S_LINE_COMM, A_NONE), [CC_LETTER] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_E] = FSM_T(S_LINE_COMM, A_NONE), [CC_N] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_T] = FSM_T(S_LINE_COMM, A_NONE), [CC_DIGIT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_EOL] = FSM_T(S_INIT, A_NEW_ROW), [CC_SPACE] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_SLASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_PLUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_STAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_GT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_LT] = FSM_T(S_LINE_COMM, A_NONE), [CC_ASSIGN] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_COLON] = FSM_T(S_LINE_COMM, A_NONE), [CC_COMMA] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_HASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_LPAR] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_RPAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_MINUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_QUOTE] = FSM_T(S_LINE_COMM, A_NONE), [CC_DOT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_TILDE] = FSM_T(S_LINE_COMM, A_NONE), [CC_LBRACKET] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_LINE_COMM, A_NONE), [CC_BACKSLASH] = FSM_T(S_LINE_COMM, A_NONE),
+    },
+    [S_ML_COMM_1] = {
+        [CC_OTHER] = FSM_T(S_LINE_COMM, A_NONE), [CC_LETTER] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_E] = FSM_T(S_LINE_COMM, A_NONE), [CC_N] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_T] = FSM_T(S_LINE_COMM, A_NONE), [CC_DIGIT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_EOL] = FSM_T(S_LINE_COMM, A_NONE), [CC_SPACE] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_SLASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_PLUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_STAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_GT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_LT] = FSM_T(S_LINE_COMM, A_NONE), [CC_ASSIGN] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_COLON] = FSM_T(S_LINE_COMM, A_NONE), [CC_COMMA] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_HASH] = FSM_T(S_LINE_COMM, A_NONE), [CC_LPAR] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_RPAR] = FSM_T(S_LINE_COMM, A_NONE), [CC_MINUS] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_QUOTE] = FSM_T(S_LINE_COMM, A_NONE), [CC_DOT] = FSM_T(S_LINE_COMM, A_NONE),
+        [CC_TILDE] = FSM_T(S_LINE_COMM, A_NONE), [CC_LBRACKET] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_LINE_COMM, A_NONE), [CC_BACKSLASH] = FSM_T(S_LINE_COMM, A_NONE),
+    },
+    [S_ML_COMM_2] = {
+        [CC_OTHER] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LETTER] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_E] = FSM_T(S_ML_COMM_2, A_NONE), [CC_N] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_T] = FSM_T(S_ML_COMM_2, A_NONE), [CC_DIGIT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_EOL] = FSM_T(S_ML_COMM_2, A_NEW_ROW), [CC_SPACE] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_SLASH] = FSM_T(S_ML_COMM_2, A_NONE), [CC_PLUS] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_STAR] = FSM_T(S_ML_COMM_2, A_NONE), [CC_GT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_LT] = FSM_T(S_ML_COMM_2, A_NONE), [CC_ASSIGN] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_COLON] = FSM_T(S_ML_COMM_2, A_NONE), [CC_COMMA] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_HASH] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LPAR] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_RPAR] = FSM_T(S_ML_COMM_2, A_NONE), [CC_MINUS] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ML_COMM_2, A_NONE), [CC_DOT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_TILDE] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LBRACKET] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ML_COMM_3, A_NONE), [CC_BACKSLASH] = FSM_T(S_ML_COMM_2, A_NONE),
+    },
+    [S_ML_COMM_3] = {
+        [CC_OTHER] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LETTER] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_E] = FSM_T(S_ML_COMM_2, A_NONE), [CC_N] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_T] = FSM_T(S_ML_COMM_2, A_NONE), [CC_DIGIT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_EOL] = FSM_T(S_ML_COMM_2, A_NONE), [CC_SPACE] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_SLASH] = FSM_T(S_ML_COMM_2, A_NONE), [CC_PLUS] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_STAR] = FSM_T(S_ML_COMM_2, A_NONE), [CC_GT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_LT] = FSM_T(S_ML_COMM_2, A_NONE), [CC_ASSIGN] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_COLON] = FSM_T(S_ML_COMM_2, A_NONE), [CC_COMMA] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_HASH] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LPAR] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_RPAR] = FSM_T(S_ML_COMM_2, A_NONE), [CC_MINUS] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ML_COMM_2, A_NONE), [CC_DOT] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_TILDE] = FSM_T(S_ML_COMM_2, A_NONE), [CC_LBRACKET] = FSM_T(S_ML_COMM_2, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_INIT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ML_COMM_2, A_NONE),
+    },
+    [S_STR_IN] = {
+        [CC_OTHER] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_LETTER] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_E] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_N] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_T] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_DIGIT] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_SLASH] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_PLUS] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_STAR] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_GT] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_LT] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_ASSIGN] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_COLON] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_COMMA] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_HASH] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_LPAR] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_RPAR] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_MINUS] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_QUOTE] = FSM_T(S_STR_OUT, A_NONE), [CC_DOT] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_TILDE] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_LBRACKET] = FSM_T(S_STR_IN, A_NORMALIZE),
+        [CC_RBRACKET] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_BACKSLASH] = FSM_T(S_ESCAPE, A_NONE),
+    },
+    [S_STR_OUT] = {
+        [CC_OTHER] = FSM_T(S_ACCEPT, A_NONE), [CC_LETTER] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_E] = FSM_T(S_ACCEPT, A_NONE), [CC_N] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_T] = FSM_T(S_ACCEPT, A_NONE), [CC_DIGIT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_EOL] = FSM_T(S_ACCEPT, A_NONE), [CC_SPACE] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_SLASH] = FSM_T(S_ACCEPT, A_NONE), [CC_PLUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_STAR] = FSM_T(S_ACCEPT, A_NONE), [CC_GT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_LT] = FSM_T(S_ACCEPT, A_NONE), [CC_ASSIGN] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_COLON] = FSM_T(S_ACCEPT, A_NONE), [CC_COMMA] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_HASH] = FSM_T(S_ACCEPT, A_NONE), [CC_LPAR] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RPAR] = FSM_T(S_ACCEPT, A_NONE), [CC_MINUS] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ACCEPT, A_NONE), [CC_DOT] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_TILDE] = FSM_T(S_ACCEPT, A_NONE), [CC_LBRACKET] = FSM_T(S_ACCEPT, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ACCEPT, A_NONE), [CC_BACKSLASH] = FSM_T(S_ACCEPT, A_NONE),
+    },
+    [S_ESCAPE] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_STR_IN, A_ESC_EOL),
+        [CC_T] = FSM_T(S_STR_IN, A_ESC_TAB), [CC_DIGIT] = FSM_T(S_ESCAPE_D, A_ESC_DIGIT),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_STR_IN, A_NORMALIZE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_STR_IN, A_NORMALIZE),
+    },
+    [S_ESCAPE_D] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_ESCAPE_DD, A_STR_APPEND),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+    [S_ESCAPE_DD] = {
+        [CC_OTHER] = FSM_T(S_ERROR, A_NONE), [CC_LETTER] = FSM_T(S_ERROR, A_NONE),
+        [CC_E] = FSM_T(S_ERROR, A_NONE), [CC_N] = FSM_T(S_ERROR, A_NONE),
+        [CC_T] = FSM_T(S_ERROR, A_NONE), [CC_DIGIT] = FSM_T(S_STR_IN, A_STR_APPEND),
+        [CC_EOL] = FSM_T(S_ERROR, A_NONE), [CC_SPACE] = FSM_T(S_ERROR, A_NONE),
+        [CC_SLASH] = FSM_T(S_ERROR, A_NONE), [CC_PLUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_STAR] = FSM_T(S_ERROR, A_NONE), [CC_GT] = FSM_T(S_ERROR, A_NONE),
+        [CC_LT] = FSM_T(S_ERROR, A_NONE), [CC_ASSIGN] = FSM_T(S_ERROR, A_NONE),
+        [CC_COLON] = FSM_T(S_ERROR, A_NONE), [CC_COMMA] = FSM_T(S_ERROR, A_NONE),
+        [CC_HASH] = FSM_T(S_ERROR, A_NONE), [CC_LPAR] = FSM_T(S_ERROR, A_NONE),
+        [CC_RPAR] = FSM_T(S_ERROR, A_NONE), [CC_MINUS] = FSM_T(S_ERROR, A_NONE),
+        [CC_QUOTE] = FSM_T(S_ERROR, A_NONE), [CC_DOT] = FSM_T(S_ERROR, A_NONE),
+        [CC_TILDE] = FSM_T(S_ERROR, A_NONE), [CC_LBRACKET] = FSM_T(S_ERROR, A_NONE),
+        [CC_RBRACKET] = FSM_T(S_ERROR, A_NONE), [CC_BACKSLASH] = FSM_T(S_ERROR, A_NONE),
+    },
+};
+
+#endif //_SCANNER_FSM_H_
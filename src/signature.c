@@ -0,0 +1,281 @@
+/**
+ * @file signature.c
+ * Packed lists of types (signatures of functions, types of assignment's sides)
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#include "signature.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The lowest bit of every two-bit code
+ */
+#define LOW_BITS 0x5555555555555555u
+
+/**
+ * Types by their codes
+ */
+static const enum variable_type types_by_code[] = {VAR_INTEGER, VAR_NUMBER, VAR_STRING, VAR_BOOL};
+
+/**
+ * Makes mask of the first types of a word
+ *
+ * @param len Number of types
+ * @return Mask with bits of the first len types set
+ */
+static uint64_t types_mask(size_t len)
+{
+    return len >= SIGNATURE_WORD_TYPES ? UINT64_MAX : ((uint64_t) 1 << (2 * len)) - 1;
+}
+
+/**
+ * Returns words with packed codes of the signature's types
+ *
+ * @param signature Signature
+ * @return Words of the signature
+ */
+static const uint64_t *types_words(const signature_t *signature)
+{
+    return signature->len <= SIGNATURE_PACKED_TYPES ? &signature->types : signature->words;
+}
+
+/**
+ * Returns word with packed codes of the signature's types
+ *
+ * Words in a pool can be shared by longer signatures, so types after the end are masked out.
+ *
+ * @param signature Signature
+ * @param index Index of the word
+ * @return Packed codes of types (zeros after the end of the signature)
+ */
+static uint64_t types_word(const signature_t *signature, size_t index)
+{
+    size_t first = index * SIGNATURE_WORD_TYPES;
+
+    if (first >= signature->len)
+        return 0;
+
+    return types_words(signature)[index] & types_mask(signature->len - first);
+}
+
+/**
+ * Computes number of words needed for the types
+ *
+ * @param len Number of types
+ * @return Number of words
+ */
+static size_t words_count(size_t len)
+{
+    return (len + SIGNATURE_WORD_TYPES - 1) / SIGNATURE_WORD_TYPES;
+}
+
+/**
+ * Finds positions with the type
+ *
+ * @param types Packed codes of types
+ * @param type Searched type
+ * @return Lowest bits of codes equal to the type's code
+ */
+static uint64_t find_type(uint64_t types, enum variable_type type)
+{
+    // Equal codes have both bits set after the negated XOR
+    uint64_t same = ~(types ^ (SIGNATURE_CODE(type) * LOW_BITS));
+
+    return same & (same >> 1) & LOW_BITS;
+}
+
+signature_pool_t *signature_pool_create(void)
+{
+    return calloc(1, sizeof(signature_pool_t));
+}
+
+void signature_pool_destroy(signature_pool_t *pool)
+{
+    assert(pool);
+
+    struct signature_chunk *next;
+
+    while (pool->chunks) {
+        next = pool->chunks->next;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+
+    free(pool);
+}
+
+/**
+ * Finds chunk with the words of a long signature
+ *
+ * @param words Words of the signature
+ * @return Chunk containing the words
+ */
+static struct signature_chunk *chunk_of(const uint64_t *words)
+{
+    return (struct signature_chunk *) ((char *) words - offsetof(struct signature_chunk, words));
+}
+
+/**
+ * Moves types of the signature into a new chunk of the pool
+ *
+ * @param pool Pool for the chunk
+ * @param signature Signature to move
+ * @param capacity Number of words of the new chunk
+ * @return The new chunk or NULL if error occurred
+ */
+static struct signature_chunk *move_to_chunk(signature_pool_t *pool, signature_t *signature, size_t capacity)
+{
+    struct signature_chunk *chunk = calloc(1, sizeof(struct signature_chunk) + capacity * sizeof(uint64_t));
+    if (!chunk)
+        return NULL;
+
+    for (size_t i = 0; i < words_count(signature->len); i++)
+        chunk->words[i] = types_word(signature, i);
+
+    chunk->next = pool->chunks;
+    chunk->capacity = capacity;
+    chunk->used = signature->len;
+    pool->chunks = chunk;
+
+    signature->words = chunk->words;
+
+    return chunk;
+}
+
+int signature_append(signature_pool_t *pool, signature_t *signature, enum variable_type type)
+{
+    assert(signature);
+    assert(type == VAR_INTEGER || type == VAR_NUMBER || type == VAR_STRING || type == VAR_BOOL);
+
+    struct signature_chunk *chunk;
+    size_t len = signature->len;
+
+    if (len < SIGNATURE_PACKED_TYPES) {
+        signature->types |= (uint64_t) SIGNATURE_CODE(type) << (2 * len);
+        signature->len++;
+        return 0;
+    }
+
+    if (!pool || len == UINT32_MAX)
+        return -1;
+
+    // Chunk can be extended only by the longest signature in it (the others would see the new type)
+    chunk = len > SIGNATURE_PACKED_TYPES ? chunk_of(signature->words) : NULL;
+    if (!chunk || chunk->used != len || len == chunk->capacity * SIGNATURE_WORD_TYPES)
+        chunk = move_to_chunk(pool, signature, 2 * words_count(len + 1));
+
+    if (!chunk)
+        return -1;
+
+    chunk->words[len / SIGNATURE_WORD_TYPES] |=
+            (uint64_t) SIGNATURE_CODE(type) << (2 * (len % SIGNATURE_WORD_TYPES));
+    chunk->used++;
+    signature->len++;
+
+    return 0;
+}
+
+void signature_clear(signature_t *signature)
+{
+    assert(signature);
+
+    // Long signature's chunk stays in its pool (copies of the signature can use it)
+    *signature = (signature_t) SIGNATURE(0, 0);
+}
+
+enum variable_type signature_type(signature_t signature, unsigned index)
+{
+    if (index >= signature.len)
+        return 0;
+
+    return types_by_code[(types_words(&signature)[index / SIGNATURE_WORD_TYPES]
+                          >> (2 * (index % SIGNATURE_WORD_TYPES))) & 3];
+}
+
+bool signature_equal(signature_t a, signature_t b)
+{
+    if (a.len != b.len || a.varargs != b.varargs)
+        return false;
+
+    for (size_t i = 0; i < words_count(a.len); i++) {
+        if (types_word(&a, i) != types_word(&b, i))
+            return false;
+    }
+
+    return true;
+}
+
+bool signature_is_prefix(signature_t prefix, signature_t signature)
+{
+    if (prefix.len > signature.len)
+        return false;
+
+    for (size_t i = 0; i < words_count(prefix.len); i++) {
+        if (((types_word(&prefix, i) ^ types_word(&signature, i))
+             & types_mask(prefix.len - i * SIGNATURE_WORD_TYPES)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool signature_assignable(signature_t target, signature_t source)
+{
+    uint64_t mask;
+    uint64_t target_types;
+    uint64_t source_types;
+    uint64_t different;
+    uint64_t converted;
+
+    if (source.len < target.len)
+        return false;
+
+    for (size_t i = 0; i < words_count(target.len); i++) {
+        mask = types_mask(target.len - i * SIGNATURE_WORD_TYPES);
+        target_types = types_word(&target, i);
+        source_types = types_word(&source, i);
+
+        // Lowest bits of different codes and of integers assigned to numbers
+        different = target_types ^ source_types;
+        different = (different | (different >> 1)) & LOW_BITS & mask;
+        converted = find_type(target_types, VAR_NUMBER) & find_type(source_types, VAR_INTEGER) & mask;
+
+        if ((different & ~converted) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool signature_converts(signature_t target, signature_t source, unsigned index)
+{
+    return signature_type(target, index) == VAR_NUMBER && signature_type(source, index) == VAR_INTEGER;
+}
+
+char *signature_format(signature_t signature, char *buffer)
+{
+    assert(buffer);
+
+    unsigned len = signature.len < SIGNATURE_FORMAT_TYPES ? signature.len : SIGNATURE_FORMAT_TYPES;
+
+    if (signature.varargs) {
+        strcpy(buffer, "...");
+        return buffer;
+    }
+
+    for (unsigned i = 0; i < len; i++)
+        buffer[i] = (char) signature_type(signature, i);
+    buffer[len] = '\0';
+
+    if (signature.len > SIGNATURE_FORMAT_TYPES)
+        strcat(buffer, "...");
+
+    return buffer;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file signature.h
+ * Header file of packed lists of types (signatures of functions, types of assignment's sides)
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _SIGNATURE_H_
+#define _SIGNATURE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+enum variable_type {
+    VAR_INTEGER='i', VAR_NUMBER='n', VAR_STRING='s', VAR_BOOL='b'
+};
+
+/**
+ * Number of types packed into one 64-bit word
+ */
+#define SIGNATURE_WORD_TYPES 32
+
+/**
+ * Maximal number of types stored in the signature itself (longer lists are stored in a pool)
+ */
+#define SIGNATURE_PACKED_TYPES SIGNATURE_WORD_TYPES
+
+/**
+ * Maximal number of types in textual form of a signature (see signature_format())
+ */
+#define SIGNATURE_FORMAT_TYPES 32
+
+/**
+ * Size of buffer for textual form of a signature (see signature_format())
+ */
+#define SIGNATURE_BUFFER_SIZE (SIGNATURE_FORMAT_TYPES + sizeof("..."))
+
+/**
+ * Two-bit code of the type
+ *
+ * It's a constant expression, so it can be used for static signatures.
+ */
+#define SIGNATURE_CODE(type) \
+    ((type) == VAR_INTEGER ? 0u : (type) == VAR_NUMBER ? 1u : (type) == VAR_STRING ? 2u : 3u)
+
+/**
+ * Initializer of signature with the given length and already packed codes of types
+ */
+#define SIGNATURE(length, packed_types) {.types = (packed_types), .len = (length), .varargs = false}
+
+/**
+ * Initializer of signature, which takes any arguments (like write())
+ */
+#define SIGNATURE_VARARGS {.types = 0, .len = 0, .varargs = true}
+
+/**
+ * Signature in textual form for log messages (valid till the end of the enclosing block)
+ */
+#define SIGNATURE_STRING(signature) signature_format((signature), (char[SIGNATURE_BUFFER_SIZE]) {0})
+
+/**
+ * List of types packed into 64-bit words
+ *
+ * The i-th type has its code (see SIGNATURE_CODE()) at bits 2*i and 2*i+1 of its word,
+ * unused bits are zero. Up to SIGNATURE_PACKED_TYPES types are stored in the signature
+ * itself, so comparing of usual signatures is just an integer comparison. Longer lists
+ * are stored in words allocated from a pool (see signature_append()).
+ *
+ * types    packed codes of types (len <= SIGNATURE_PACKED_TYPES)
+ * words    packed codes of types in the pool (len > SIGNATURE_PACKED_TYPES)
+ * len      number of types
+ * varargs  any arguments are accepted (types aren't checked)
+ */
+typedef struct signature {
+    union {
+        uint64_t types;
+        const uint64_t *words;
+    };
+    uint32_t len;
+    bool varargs;
+} signature_t;
+
+/**
+ * Chunk of words of a long signature
+ *
+ * Signatures are copied by value, so more of them can share the chunk. The chunk
+ * remembers, how many types are written into it, so only the longest of them appends in place.
+ *
+ * Content:
+ * <ul>
+ *      <li><code>next</code> - Previously allocated chunk</li>
+ *      <li><code>capacity</code> - Number of words</li>
+ *      <li><code>used</code> - Number of types written into words</li>
+ *      <li><code>words</code> - Packed codes of types</li>
+ * </ul>
+ */
+struct signature_chunk {
+    struct signature_chunk *next;
+    size_t capacity;
+    size_t used;
+    uint64_t words[];
+};
+
+/**
+ * Pool for types of long signatures
+ *
+ * It's a compilation-lifetime storage, all chunks are released at once with the pool.
+ */
+typedef struct signature_pool {
+    struct signature_chunk *chunks;
+} signature_pool_t;
+
+/**
+ * Creates a new empty pool
+ *
+ * @return Pointer to the new pool or NULL if error occurred
+ */
+signature_pool_t *signature_pool_create(void);
+
+/**
+ * Destroys the pool with all long signatures stored in it
+ *
+ * @param pool Pool to destroy
+ *
+ * @pre pool != NULL
+ */
+void signature_pool_destroy(signature_pool_t *pool);
+
+/**
+ * Appends type to the end of the signature
+ *
+ * @param pool Pool for types of long signatures (it can be NULL for signatures
+ *             with up to SIGNATURE_PACKED_TYPES types)
+ * @param signature Signature to modify
+ * @param type Appended type
+ * @return 0 on success, negative error code if the types can't be stored
+ *
+ * @pre signature != NULL
+ */
+int signature_append(signature_pool_t *pool, signature_t *signature, enum variable_type type);
+
+/**
+ * Removes all types from the signature
+ *
+ * @param signature Signature to clear
+ *
+ * @pre signature != NULL
+ */
+void signature_clear(signature_t *signature);
+
+/**
+ * Returns type at the position
+ *
+ * @param signature Signature
+ * @param index Position of the type
+ * @return Type at the position or 0 if the signature is shorter
+ */
+enum variable_type signature_type(signature_t signature, unsigned index);
+
+/**
+ * Checks if signatures contain the same types
+ *
+ * @param a The first signature
+ * @param b The second signature
+ * @return Are the signatures equal?
+ */
+bool signature_equal(signature_t a, signature_t b);
+
+/**
+ * Checks if signature starts with the types of the prefix
+ *
+ * @param prefix Expected beginning of the signature
+ * @param signature Checked signature
+ * @return Is prefix really prefix of the signature?
+ */
+bool signature_is_prefix(signature_t prefix, signature_t signature);
+
+/**
+ * Checks if values of source types can be assigned to targets
+ *
+ * Source can have more types than target (redundant values are dropped).
+ * Integer can be assigned to number (implicit conversion is needed, see signature_converts()).
+ *
+ * @param target Types of targets of assignment
+ * @param source Types of assigned values
+ * @return Can be the values assigned?
+ */
+bool signature_assignable(signature_t target, signature_t source);
+
+/**
+ * Checks if the i-th value needs implicit conversion when it's assigned
+ *
+ * @param target Types of targets of assignment
+ * @param source Types of assigned values
+ * @param index Position of the value
+ * @return Is integer assigned to number at the position?
+ */
+bool signature_converts(signature_t target, signature_t source, unsigned index);
+
+/**
+ * Writes signature in textual form (like "snn", "..." for varargs)
+ *
+ * Only the first SIGNATURE_FORMAT_TYPES types are written, "..." is appended
+ * to longer signatures.
+ *
+ * @param signature Signature
+ * @param buffer Buffer with SIGNATURE_BUFFER_SIZE characters at least
+ * @return The buffer
+ *
+ * @pre buffer != NULL
+ */
+char *signature_format(signature_t signature, char *buffer);
+
+#endif //_SIGNATURE_H_
@@ -0,0 +1,363 @@
+/**
+ * @file source.c
+ * Input source for scanner
+ *
+ * It loads the whole input program into memory (mmap for regular files,
+ * chunked reading for pipes etc.) and provides vectorized skipping over it
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+// mmap(), fstat() and fileno() are POSIX functions
+#define _POSIX_C_SOURCE 200809L
+
+#include "source.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// SIMD implementations of skipping are available only for x86 with GCC-compatible compiler
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define SOURCE_SIMD_SKIP
+#include <immintrin.h>
+#endif
+
+/**
+ * Number of characters checked by scalar code before vectorized skipping is used
+ */
+#define SKIP_PROBE_LEN 8
+
+/**
+ * Tries to map the whole regular file into memory
+ *
+ * @param src Source to fill
+ * @param stream Opened stream with regular file
+ * @return Was the file mapped?
+ */
+static bool map_file(source_t *src, FILE *stream)
+{
+    struct stat file_info;
+    void *mapped;
+    int fd = fileno(stream);
+
+    if (fd < 0 || fstat(fd, &file_info) < 0 || !S_ISREG(file_info.st_mode))
+        return false;
+
+    // Somebody has already read a part of the file, so it can't be mapped from the start
+    if (lseek(fd, 0, SEEK_CUR) != 0)
+        return false;
+
+    src->len = (size_t) file_info.st_size;
+    src->storage = SRC_MAPPED;
+
+    // Empty files can't be mapped, but there is nothing to read anyway
+    if (src->len == 0) {
+        src->data = NULL;
+        return true;
+    }
+
+    mapped = mmap(NULL, src->len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    src->data = mapped;
+
+    return true;
+}
+
+/**
+ * Reads the whole stream by chunks into one buffer
+ *
+ * @param src Source to fill
+ * @param stream Opened stream
+ * @return Was the stream successfully read?
+ */
+static bool read_stream(source_t *src, FILE *stream)
+{
+    char *buffer = NULL;
+    char *grown;
+    size_t capacity = 0;
+    size_t len = 0;
+    size_t loaded;
+
+    do {
+        // There must be space for the whole chunk
+        if (capacity - len < SOURCE_CHUNK_SIZE) {
+            capacity = capacity ? 2 * capacity : SOURCE_CHUNK_SIZE;
+            grown = realloc(buffer, capacity);
+            if (!grown) {
+                free(buffer);
+                return false;
+            }
+
+            buffer = grown;
+        }
+
+        loaded = fread(buffer + len, 1, SOURCE_CHUNK_SIZE, stream);
+        len += loaded;
+    } while (loaded == SOURCE_CHUNK_SIZE);
+
+    if (ferror(stream)) {
+        free(buffer);
+        return false;
+    }
+
+    src->data = buffer;
+    src->len = len;
+    src->storage = SRC_BUFFER;
+
+    return true;
+}
+
+/**
+ * Skips characters one by one (fallback for all CPUs and tails of SIMD implementations)
+ */
+static size_t skip_scalar(const unsigned char *data, size_t len, enum source_skip_target target)
+{
+    const unsigned char *eol;
+    size_t i = 0;
+
+    switch (target) {
+        case SKIP_TO_EOL:
+            // memchr() is optimized by C library
+            eol = memchr(data, '\n', len);
+
+            return eol ? (size_t) (eol - data) : len;
+        case SKIP_TO_EOL_OR_RBRACKET:
+            while (i < len && data[i] != '\n' && data[i] != ']')
+                i++;
+
+            return i;
+        case SKIP_TO_STRING_SPECIAL:
+            while (i < len && data[i] > ' ' && data[i] != '"' && data[i] != '#' && data[i] != '\\')
+                i++;
+
+            return i;
+    }
+
+    return len;
+}
+
+#ifdef SOURCE_SIMD_SKIP
+/**
+ * Rows of simd_stop_chars table
+ */
+enum simd_stop_char {
+    STOP_EOL, STOP_RBRACKET, STOP_SPACE, STOP_QUOTE, STOP_HASH, STOP_BACKSLASH
+};
+
+/**
+ * Stop characters broadcast to the whole vector
+ *
+ * Vectors are loaded from memory, because building them by _mm*_set1_epi8()
+ * is very slow in non-optimized builds (the project is compiled without -O).
+ */
+static const char simd_stop_chars[][32] = {
+#define BROADCAST(c) {c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c}
+    [STOP_EOL] = BROADCAST('\n'),
+    [STOP_RBRACKET] = BROADCAST(']'),
+    [STOP_SPACE] = BROADCAST(' '),
+    [STOP_QUOTE] = BROADCAST('"'),
+    [STOP_HASH] = BROADCAST('#'),
+    [STOP_BACKSLASH] = BROADCAST('\\'),
+#undef BROADCAST
+};
+
+/**
+ * Skips characters by 16-byte blocks using SSE2 instructions
+ */
+static size_t skip_sse2(const unsigned char *data, size_t len, enum source_skip_target target)
+{
+    const __m128i eol = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_EOL]);
+    const __m128i rbracket = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_RBRACKET]);
+    const __m128i space = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_SPACE]);
+    const __m128i quote = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_QUOTE]);
+    const __m128i hash = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_HASH]);
+    const __m128i backslash = _mm_loadu_si128((const __m128i *) simd_stop_chars[STOP_BACKSLASH]);
+    __m128i block;
+    __m128i stops;
+    unsigned mask;
+    size_t i;
+
+    for (i = 0; i + sizeof(__m128i) <= len; i += sizeof(__m128i)) {
+        block = _mm_loadu_si128((const __m128i *) (data + i));
+
+        if (target == SKIP_TO_STRING_SPECIAL) {
+            // Unsigned block <= ' ' (covers EOL and other control characters)
+            stops = _mm_cmpeq_epi8(_mm_min_epu8(block, space), block);
+            stops = _mm_or_si128(stops, _mm_cmpeq_epi8(block, quote));
+            stops = _mm_or_si128(stops, _mm_cmpeq_epi8(block, hash));
+            stops = _mm_or_si128(stops, _mm_cmpeq_epi8(block, backslash));
+        } else {
+            stops = _mm_cmpeq_epi8(block, eol);
+            if (target == SKIP_TO_EOL_OR_RBRACKET)
+                stops = _mm_or_si128(stops, _mm_cmpeq_epi8(block, rbracket));
+        }
+
+        mask = (unsigned) _mm_movemask_epi8(stops);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+
+    return i + skip_scalar(data + i, len - i, target);
+}
+
+/**
+ * Skips characters by 32-byte blocks using AVX2 instructions
+ */
+__attribute__((target("avx2")))
+static size_t skip_avx2(const unsigned char *data, size_t len, enum source_skip_target target)
+{
+    const __m256i eol = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_EOL]);
+    const __m256i rbracket = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_RBRACKET]);
+    const __m256i space = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_SPACE]);
+    const __m256i quote = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_QUOTE]);
+    const __m256i hash = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_HASH]);
+    const __m256i backslash = _mm256_loadu_si256((const __m256i *) simd_stop_chars[STOP_BACKSLASH]);
+    __m256i block;
+    __m256i stops;
+    unsigned mask;
+    size_t i;
+
+    for (i = 0; i + sizeof(__m256i) <= len; i += sizeof(__m256i)) {
+        block = _mm256_loadu_si256((const __m256i *) (data + i));
+
+        if (target == SKIP_TO_STRING_SPECIAL) {
+            // Unsigned block <= ' ' (covers EOL and other control characters)
+            stops = _mm256_cmpeq_epi8(_mm256_min_epu8(block, space), block);
+            stops = _mm256_or_si256(stops, _mm256_cmpeq_epi8(block, quote));
+            stops = _mm256_or_si256(stops, _mm256_cmpeq_epi8(block, hash));
+            stops = _mm256_or_si256(stops, _mm256_cmpeq_epi8(block, backslash));
+        } else {
+            stops = _mm256_cmpeq_epi8(block, eol);
+            if (target == SKIP_TO_EOL_OR_RBRACKET)
+                stops = _mm256_or_si256(stops, _mm256_cmpeq_epi8(block, rbracket));
+        }
+
+        mask = (unsigned) _mm256_movemask_epi8(stops);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+
+    return i + skip_sse2(data + i, len - i, target);
+}
+#endif
+
+bool source_use_skip_impl(source_t *src, enum source_skip_impl impl)
+{
+    assert(src);
+
+    switch (impl) {
+        case SKIP_IMPL_SCALAR:
+            src->skip = skip_scalar;
+
+            return true;
+#ifdef SOURCE_SIMD_SKIP
+        case SKIP_IMPL_SSE2:
+            src->skip = skip_sse2;
+
+            return true;
+        case SKIP_IMPL_AVX2:
+            if (!__builtin_cpu_supports("avx2"))
+                return false;
+
+            src->skip = skip_avx2;
+
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * Selects the best implementation of skipping available on this CPU
+ *
+ * @param src Source to set the implementation for
+ */
+static void select_skip_impl(source_t *src)
+{
+    if (!source_use_skip_impl(src, SKIP_IMPL_AVX2) && !source_use_skip_impl(src, SKIP_IMPL_SSE2))
+        source_use_skip_impl(src, SKIP_IMPL_SCALAR);
+}
+
+size_t source_skip(source_t *src, enum source_skip_target target)
+{
+    assert(src);
+
+    const unsigned char *data;
+    size_t len;
+    size_t probe;
+    size_t skipped;
+
+    if (src->pos >= src->len)
+        return 0;
+
+    data = (const unsigned char *) src->data + src->pos;
+    len = src->len - src->pos;
+
+    // Short runs (words in string literals etc.) are common and they're faster to check one by one
+    probe = len < SKIP_PROBE_LEN ? len : SKIP_PROBE_LEN;
+    skipped = skip_scalar(data, probe, target);
+    if (skipped == probe && probe < len)
+        skipped += src->skip(data + probe, len - probe, target);
+
+    src->pos += skipped;
+
+    return skipped;
+}
+
+source_t *source_create(FILE *stream)
+{
+    assert(stream);
+
+    source_t *src = malloc(sizeof(source_t));
+    if (!src)
+        return NULL;
+
+    src->pos = 0;
+    select_skip_impl(src);
+
+    if (!map_file(src, stream) && !read_stream(src, stream)) {
+        free(src);
+        return NULL;
+    }
+
+    return src;
+}
+
+source_t *source_from_memory(const char *data, size_t len)
+{
+    source_t *src = malloc(sizeof(source_t));
+    if (!src)
+        return NULL;
+
+    src->data = data;
+    src->len = len;
+    src->pos = 0;
+    src->storage = SRC_BORROWED;
+    select_skip_impl(src);
+
+    return src;
+}
+
+void source_destroy(source_t *src)
+{
+    assert(src);
+
+    if (src->storage == SRC_MAPPED && src->data)
+        munmap((void *) src->data, src->len);
+    else if (src->storage == SRC_BUFFER)
+        free((void *) src->data);
+
+    free(src);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file source.h
+ * Header file of input source for scanner
+ *
+ * Source holds the whole input program in one buffer, so scanner can move
+ * over it with a simple cursor instead of calling stdio for every character
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _SOURCE_H_
+#define _SOURCE_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Size of one chunk for reading from non-seekable streams (pipes etc.)
+ */
+#define SOURCE_CHUNK_SIZE 65536
+
+/**
+ * Reads next character from the source and moves cursor behind it
+ *
+ * Returns EOF at the end of the source (cursor stays there).
+ */
+#define SOURCE_GETC(src) ((src)->pos < (src)->len ? (unsigned char) (src)->data[(src)->pos++] : EOF)
+/**
+ * Moves cursor back by one character
+ *
+ * It can be used only after successful SOURCE_GETC() (not after EOF).
+ */
+#define SOURCE_UNGETC(src) ((src)->pos--)
+
+/**
+ * Where the content of the source is stored (and how to release it)
+ */
+enum source_storage {
+    SRC_BUFFER, SRC_MAPPED, SRC_BORROWED
+};
+
+/**
+ * Characters the skipping stops at
+ *
+ * <ul>
+ *      <li><code>SKIP_TO_EOL</code> - EOL (line comments)</li>
+ *      <li><code>SKIP_TO_EOL_OR_RBRACKET</code> - EOL and ']' (multi-line comments)</li>
+ *      <li><code>SKIP_TO_STRING_SPECIAL</code> - control characters, space, '"', '#' and '\\' (characters
+ *          of string literal, which can't be copied as they are)</li>
+ * </ul>
+ */
+enum source_skip_target {
+    SKIP_TO_EOL, SKIP_TO_EOL_OR_RBRACKET, SKIP_TO_STRING_SPECIAL
+};
+
+/**
+ * Implementations of skipping
+ */
+enum source_skip_impl {
+    SKIP_IMPL_SCALAR, SKIP_IMPL_SSE2, SKIP_IMPL_AVX2
+};
+
+/**
+ * Signature of skipping implementations
+ *
+ * @param data Characters to search in
+ * @param len Number of characters
+ * @param target Set of characters to stop at
+ * @return Index of the first character from target set or len if there is no one
+ */
+typedef size_t (*source_skip_fn)(const unsigned char *data, size_t len, enum source_skip_target target);
+
+/**
+ * Input source loaded into memory
+ *
+ * Content:
+ * <ul>
+ *      <li><code>data</code> - Whole input (not null-terminated)</li>
+ *      <li><code>len</code> - Length of the input in bytes</li>
+ *      <li><code>pos</code> - Cursor (index of the next character to read)</li>
+ *      <li><code>storage</code> - Type of memory the data are stored in</li>
+ *      <li><code>skip</code> - Implementation of skipping (the best one for the CPU is selected on creation)</li>
+ * </ul>
+ */
+typedef struct source {
+    const char *data;
+    size_t len;
+    size_t pos;
+    enum source_storage storage;
+    source_skip_fn skip;
+} source_t;
+
+/**
+ * Loads the whole stream into a new source
+ *
+ * Regular files are memory mapped. Other streams (pipes, terminals etc.)
+ * are read by chunks into one growing buffer until EOF.
+ *
+ * @param stream Opened input stream
+ * @return Pointer to the new source or NULL if error occurred
+ *
+ * @pre stream != NULL
+ */
+source_t *source_create(FILE *stream);
+
+/**
+ * Creates a new source over the existing memory
+ *
+ * Memory isn't copied, so it must be valid until the source is destroyed.
+ *
+ * @param data Source content
+ * @param len Length of the content in bytes
+ * @return Pointer to the new source or NULL if error occurred
+ */
+source_t *source_from_memory(const char *data, size_t len);
+
+/**
+ * Destroys source and releases loaded content
+ *
+ * @param src Source to destroy
+ *
+ * @pre src != NULL
+ */
+void source_destroy(source_t *src);
+
+/**
+ * Moves cursor to the nearest character of the target set (or to the end of the source)
+ *
+ * It's used for jumping over long runs of characters, which don't change scanner's state
+ * (comments, string literals). The best implementation available on the CPU is used
+ * (AVX2, SSE2, scalar fallback).
+ *
+ * @param src Source to move in
+ * @param target Set of characters to stop at
+ * @return Number of skipped characters
+ *
+ * @pre src != NULL
+ */
+size_t source_skip(source_t *src, enum source_skip_target target);
+
+/**
+ * Forces the implementation of skipping in the source (it's intended for tests and benchmarks)
+ *
+ * @param src Source to set the implementation for
+ * @param impl Required implementation
+ * @return Is the implementation supported on this CPU (and so used by the source from now)?
+ *
+ * @pre src != NULL
+ */
+bool source_use_skip_impl(source_t *src, enum source_skip_impl impl);
+
+#endif //_SOURCE_H_
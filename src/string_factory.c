@@ -6,6 +6,7 @@
  * Team: 128 (variant II)
  *
  * @author Martin Havlík (xhavli56)
+ * @author Michal Šmahel (xsmahe01)
  */
 
 #include "string_factory.h"
@@ -64,6 +65,38 @@ int string_appendc(string_t *str, char c)
     return 0;
 }
 
+int string_appendn(string_t *str, const char *chars, size_t n)
+{
+    assert(str);
+    char *grown;
+    size_t new_max = str->max_len;
+
+    if (n == 0)
+        return 0;
+
+    // There must be a space for the terminating null byte, too
+    while (str->len + n >= new_max)
+        new_max *= 2;
+
+    if (new_max != str->max_len) {
+        grown = calloc(new_max, 1);
+        if (!grown) {
+            return -errno;
+        }
+        str->max_len = new_max;
+
+        memcpy(grown, str->content, str->len);
+
+        free(str->content);
+        str->content = grown;
+    }
+
+    memcpy(str->content + str->len, chars, n);
+    str->len += n;
+
+    return 0;
+}
+
 int string_cmp(string_t *str1, string_t *str2)
 {
     assert(str1);
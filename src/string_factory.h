@@ -49,6 +49,20 @@ void string_destroy(string_t *str);
  */
 int string_appendc(string_t *str, char c);
 
+/**
+ * Appends a run of characters to the string.
+ *
+ * @param str String to which to append to.
+ * @param chars Characters to append (don't need to be null-terminated).
+ * @param n Number of characters to append.
+ *
+ * @pre str != NULL
+ * @pre chars != NULL || n == 0
+ *
+ * @return 0 on successful append, negative value otherwise.
+ */
+int string_appendn(string_t *str, const char *chars, size_t n);
+
 /**
  * Compares two strings.
  *
@@ -0,0 +1,131 @@
+/**
+ * @file strpool.c
+ * Pool for string literals
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#include "strpool.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+/**
+ * Adds a new chunk with space for (at least) the given number of characters
+ *
+ * The pending string is moved into the new chunk, so it stays contiguous.
+ *
+ * @param pool Pool to add chunk to
+ * @param required Required free space (the pending string not included)
+ * @return 0 if success otherwise negative error code
+ */
+static int add_chunk(strpool_t *pool, size_t required)
+{
+    struct strpool_chunk *chunk;
+    size_t size = STRPOOL_CHUNK_SIZE;
+
+    while (size < pool->pending + required)
+        size *= 2;
+
+    chunk = malloc(sizeof(struct strpool_chunk) + size);
+    if (!chunk)
+        return -ENOMEM;
+
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = pool->chunks;
+
+    if (pool->chunks && pool->pending > 0)
+        memcpy(chunk->data, pool->chunks->data + pool->chunks->used, pool->pending);
+
+    pool->chunks = chunk;
+
+    return 0;
+}
+
+strpool_t *strpool_create(void)
+{
+    strpool_t *pool = malloc(sizeof(strpool_t));
+    if (!pool)
+        return NULL;
+
+    pool->chunks = NULL;
+    pool->pending = 0;
+
+    return pool;
+}
+
+int strpool_appendn(strpool_t *pool, const char *chars, size_t n)
+{
+    assert(pool);
+
+    struct strpool_chunk *chunk = pool->chunks;
+    int ret;
+
+    if (n == 0)
+        return 0;
+
+    // There must be a space for the terminating null byte, too
+    if (!chunk || chunk->size - chunk->used - pool->pending < n + 1) {
+        if ((ret = add_chunk(pool, n + 1)) < 0)
+            return ret;
+
+        chunk = pool->chunks;
+    }
+
+    memcpy(chunk->data + chunk->used + pool->pending, chars, n);
+    pool->pending += n;
+
+    return 0;
+}
+
+char *strpool_finish(strpool_t *pool)
+{
+    assert(pool);
+
+    struct strpool_chunk *chunk = pool->chunks;
+    char *string;
+
+    // Empty string needs a space for null byte only
+    if (!chunk || chunk->size - chunk->used - pool->pending < 1) {
+        if (add_chunk(pool, 1) < 0)
+            return NULL;
+
+        chunk = pool->chunks;
+    }
+
+    string = chunk->data + chunk->used;
+    string[pool->pending] = '\0';
+
+    chunk->used += pool->pending + 1;
+    pool->pending = 0;
+
+    return string;
+}
+
+void strpool_discard(strpool_t *pool)
+{
+    assert(pool);
+
+    pool->pending = 0;
+}
+
+void strpool_destroy(strpool_t *pool)
+{
+    assert(pool);
+
+    struct strpool_chunk *chunk = pool->chunks;
+    struct strpool_chunk *next;
+
+    while (chunk) {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(pool);
+}
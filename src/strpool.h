@@ -0,0 +1,105 @@
+/**
+ * @file strpool.h
+ * Header file of pool for string literals
+ *
+ * Pool is a compilation-lifetime storage of null-terminated strings. Strings
+ * are written into big chunks one after another, so each of them doesn't need
+ * its own allocation. All of them are released at once with the pool.
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _STRPOOL_H_
+#define _STRPOOL_H_
+
+#include <stdlib.h>
+
+/**
+ * Minimal size of one chunk of the pool
+ */
+#define STRPOOL_CHUNK_SIZE 65536
+
+/**
+ * Chunk of the pool's memory
+ *
+ * Content:
+ * <ul>
+ *      <li><code>next</code> - Previously filled chunk</li>
+ *      <li><code>size</code> - Capacity of data</li>
+ *      <li><code>used</code> - Space taken by finished strings</li>
+ *      <li><code>data</code> - Stored strings</li>
+ * </ul>
+ */
+struct strpool_chunk {
+    struct strpool_chunk *next;
+    size_t size;
+    size_t used;
+    char data[];
+};
+
+/**
+ * Pool for strings
+ *
+ * The string being built is stored behind finished strings of the first chunk
+ * (pending is its length).
+ */
+typedef struct strpool {
+    struct strpool_chunk *chunks;
+    size_t pending;
+} strpool_t;
+
+/**
+ * Creates a new empty pool
+ *
+ * @return Pointer to the new pool or NULL if error occurred
+ */
+strpool_t *strpool_create(void);
+
+/**
+ * Appends characters to the string being built
+ *
+ * @param pool Pool to append to
+ * @param chars Characters to append (don't need to be null-terminated)
+ * @param n Number of characters
+ * @return 0 if success otherwise negative error code
+ *
+ * @pre pool != NULL
+ * @pre chars != NULL || n == 0
+ */
+int strpool_appendn(strpool_t *pool, const char *chars, size_t n);
+
+/**
+ * Finishes the string being built
+ *
+ * The string is valid until the pool is destroyed. The next appending
+ * starts a new string.
+ *
+ * @param pool Pool with the string
+ * @return Finished null-terminated string or NULL if error occurred
+ *
+ * @pre pool != NULL
+ */
+char *strpool_finish(strpool_t *pool);
+
+/**
+ * Throws away the string being built (if there is any)
+ *
+ * @param pool Pool with the string
+ *
+ * @pre pool != NULL
+ */
+void strpool_discard(strpool_t *pool);
+
+/**
+ * Destroys pool with all strings stored in it
+ *
+ * @param pool Pool to destroy
+ *
+ * @pre pool != NULL
+ */
+void strpool_destroy(strpool_t *pool);
+
+#endif //_STRPOOL_H_
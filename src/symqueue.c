@@ -6,6 +6,7 @@
  * Team: 128 (variant II)
  *
  * @author Pavel Osinek (xosine00)
+ * @author Michal Šmahel (xsmahe01)
  */
 
 #include "symqueue.h"
@@ -14,7 +15,6 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <assert.h>
-#include <errno.h>
 
 symqueue_t *symqueue_create(void)
 {
@@ -23,31 +23,57 @@ symqueue_t *symqueue_create(void)
         return NULL;
     }
 
-    q->front = NULL;
-    q->rear = NULL;
+    q->items = malloc(SYMQUEUE_INITIAL_CAPACITY * sizeof(identifier_t *));
+    if (!q->items) {
+        free(q);
+        return NULL;
+    }
+
+    q->capacity = SYMQUEUE_INITIAL_CAPACITY;
+    q->front = 0;
+    q->count = 0;
 
     return q;
 }
 
+/**
+ * Doubles capacity of symqueue
+ *
+ * @param q symqueue
+ * @return If grow was successful
+ */
+static bool symqueue_grow(symqueue_t *q)
+{
+    identifier_t **items = malloc(2 * q->capacity * sizeof(identifier_t *));
+    if (!items) {
+        return false;
+    }
+
+    // Items are unwrapped, so the first in item is at the beginning of the new array
+    for (size_t i = 0; i < q->count; i++) {
+        items[i] = q->items[(q->front + i) & (q->capacity - 1)];
+    }
+
+    free(q->items);
+    q->items = items;
+    q->capacity *= 2;
+    q->front = 0;
+
+    return true;
+}
+
 bool symqueue_add(symqueue_t *q, identifier_t *item)
 {
     assert(q);
     assert(item);
 
-    struct symqueue_node *tmp = malloc(sizeof(struct symqueue_node));
-    if (!tmp) {
-        return -ENOMEM;
-    }
-    tmp->item = item;
-    if (q->front == NULL) {
-        q->front = tmp;
-        q->rear = tmp;
-        q->front->next = NULL;
-    } else {
-        q->rear->next = tmp;
-        q->rear = tmp;
-        q->rear->next = NULL;
+    if (q->count == q->capacity && !symqueue_grow(q)) {
+        return false;
     }
+
+    q->items[(q->front + q->count) & (q->capacity - 1)] = item;
+    q->count++;
+
     return true;
 }
 
@@ -55,56 +81,52 @@ identifier_t *symqueue_peek(symqueue_t *q)
 {
     assert(q);
 
-    if (q->front == NULL) {
+    if (q->count == 0) {
         return NULL;
     }
-    
-    return q->front->item;
+
+    return q->items[q->front];
 }
 
 identifier_t *symqueue_rear(symqueue_t *q)
 {
     assert(q);
 
-    if (q->rear == NULL) {
+    if (q->count == 0) {
         return NULL;
     }
-    return q->rear->item;
+
+    return q->items[(q->front + q->count - 1) & (q->capacity - 1)];
 }
 
 identifier_t *symqueue_pop(symqueue_t *q)
 {
     assert(q);
 
-    struct symqueue_node *tmp;
     identifier_t *item;
 
-    if (q->front == NULL) {
+    if (q->count == 0) {
         return NULL; //empty queue
-    } else {
-        tmp = q->front;
-        item = tmp->item;
-        q->front = q->front->next;
-        
-        if (q->front == NULL) {
-            q->rear = NULL;
-        }
-        
-        free(tmp);
-        return item;
     }
+
+    item = q->items[q->front];
+    q->front = (q->front + 1) & (q->capacity - 1);
+    q->count--;
+
+    return item;
 }
 
 bool symqueue_is_empty(symqueue_t *q)
 {
     assert(q);
 
-    return (q->front == NULL);
+    return (q->count == 0);
 }
 
 void symqueue_destroy(symqueue_t *q)
 {
     assert(q);
 
+    free(q->items);
     free(q);
 }
@@ -18,22 +18,23 @@
 #include <stdlib.h>
 
 /**
- * @struct Symqueue_node
+ * Initial capacity of symqueue (must be a power of 2, it's doubled when needed)
  */
-struct symqueue_node {
-    identifier_t *item;
-    struct symqueue_node *next;
-};
+#define SYMQUEUE_INITIAL_CAPACITY 16
 
 /**
  * @struct Symqueue
  *
- * ADT Queue for code generator implemented as singly linked list
+ * ADT Queue for code generator implemented as growable circular array
  *
+ * The array is reused by the next items, so adding doesn't allocate
+ * anything unless there are more queued items than ever before.
  */
 struct symqueue {
-    struct symqueue_node *front;    //first in item
-    struct symqueue_node *rear;     //last in item
+    identifier_t **items;   //circular array of items
+    size_t capacity;        //size of the array (power of 2)
+    size_t front;           //index of first in item
+    size_t count;           //number of queued items
 };
 
 typedef struct symqueue symqueue_t;
@@ -49,6 +50,7 @@ symqueue_t *symqueue_create(void);
  * Adds new symtable item to symqueue as last in item
  *
  * @param q symqueue
+ * @param item Added item
  * @return If add was successful
  *
  * @pre q != NULL
@@ -90,18 +92,18 @@ identifier_t *symqueue_pop(symqueue_t *q);
  * Checks if symqueue is empty
  *
  * @param q symqueue
- * @return Is there any node?
+ * @return Is there any item?
  *
  * @pre q != NULL
  */
 bool symqueue_is_empty(symqueue_t *q);
 
 /**
- * Destroys empty symqueue
+ * Destroys symqueue (queued items aren't freed)
  *
  * @param q symqueue
  *
- * @pre q != NULL; symqueue_is_empty(q) == true
+ * @pre q != NULL
  */
 void symqueue_destroy(symqueue_t *q);
 
@@ -1,6 +1,6 @@
 /**
  * @file symstack.c
- * Stack-like storage for tables of symbols
+ * Scoped storage of symbols (global table and nested block scopes)
  *
  * IFJ and IAL project (IFJ21 compiler)
  * Team: 128 (variant II)
@@ -15,116 +15,374 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 
-symstack_t *symstack_create(void)
+symstack_t *symstack_create(symtable_t *global)
 {
+    assert(global);
+
     symstack_t *s = malloc(sizeof(symstack_t));
     if (!s)
         return NULL;
 
-    s->top = NULL;
-    s->act = NULL;
+    s->slots = calloc(SYMSTACK_INITIAL_SLOTS, sizeof(struct symstack_slot));
+    s->bindings = malloc(SYMSTACK_INITIAL_BINDINGS * sizeof(struct symstack_binding));
+    s->scopes = malloc(SYMSTACK_INITIAL_SCOPES * sizeof(struct symstack_scope));
+    if (!s->slots || !s->bindings || !s->scopes) {
+        free(s->slots);
+        free(s->bindings);
+        free(s->scopes);
+        free(s);
+        return NULL;
+    }
+
+    s->global = global;
+    s->slot_count = SYMSTACK_INITIAL_SLOTS;
+    s->name_count = 0;
+    s->binding_count = 0;
+    s->binding_cap = SYMSTACK_INITIAL_BINDINGS;
+    s->scope_count = 0;
+    s->scope_cap = SYMSTACK_INITIAL_SCOPES;
+    s->blocks = NULL;
+    s->current = NULL;
+    memset(s->builtins, 0, sizeof(s->builtins));
 
     return s;
 }
 
-int symstack_push(symstack_t *s, symtable_t *symtable)
+/**
+ * Finds slot of the name (the one with its bindings or the empty one, where it belongs)
+ *
+ * @param s Pointer to symstack
+ * @param atom Interned name
+ * @return Pointer to the slot
+ */
+static struct symstack_slot *find_slot(symstack_t *s, const atom_t *atom)
 {
-    assert(s);
-    assert(symtable);
+    size_t mask = s->slot_count - 1;
+    size_t i = atom->hash & mask;
+
+    // Names are interned, so atoms are compared directly
+    while (s->slots[i].atom && s->slots[i].atom != atom)
+        i = (i + 1) & mask;
+
+    return &s->slots[i];
+}
 
-    // Allocate new node for storing symtable
-    struct symstack_node *tmp = malloc(sizeof(struct symstack_node));
-    if (!tmp)
+/**
+ * Doubles the number of map's slots
+ *
+ * @param s Pointer to symstack
+ * @return 0 on success, negative value otherwise
+ */
+static int grow_slots(symstack_t *s)
+{
+    struct symstack_slot *old_slots = s->slots;
+    size_t old_count = s->slot_count;
+
+    s->slots = calloc(old_count * 2, sizeof(struct symstack_slot));
+    if (!s->slots) {
+        s->slots = old_slots;
         return -ENOMEM;
+    }
+    s->slot_count = old_count * 2;
 
-    // Initialize new node
-    tmp->item = symtable;
-    tmp->next = s->top;
-    s->top = tmp;
+    for (size_t i = 0; i < old_count; i++) {
+        if (old_slots[i].atom)
+            *find_slot(s, old_slots[i].atom) = old_slots[i];
+    }
+
+    free(old_slots);
 
     return 0;
 }
 
-symtable_t *symstack_pop(symstack_t *s)
+int symstack_push_scope(symstack_t *s)
 {
     assert(s);
 
-    struct symstack_node *top_node;
-    symtable_t *symtable;
+    struct symstack_scope *scopes;
+    size_t capacity;
 
-    if (!s->top)
-        // Symstack is empty
-        return NULL;
+    if (s->scope_count == s->scope_cap) {
+        capacity = s->scope_cap * 2;
+        scopes = realloc(s->scopes, capacity * sizeof(struct symstack_scope));
+        if (!scopes)
+            return -ENOMEM;
 
-    if (s->top == s->act)
-        // Active symtable will be removed --> it can't be active anymore
-        s->act = NULL;
+        s->scopes = scopes;
+        s->scope_cap = capacity;
+    }
 
-    // Extract symtable from the top node
-    top_node = s->top;
-    symtable = top_node->item;
+    SYMTABLE_STAT(symtable_stats.scopes_entered++);
+    SYMTABLE_STAT(if (s->scope_count + 1 > symtable_stats.max_depth) symtable_stats.max_depth = s->scope_count + 1);
 
-    // Delete top node from the symstack
-    s->top = top_node->next;
-    free(top_node);
+    // Remember where the scope starts, so leaving it is only rollback to this state
+    s->scopes[s->scope_count++] = (struct symstack_scope) {
+            .bindings = s->binding_count,
+            .block = s->current,
+            .used = s->current ? s->current->used : 0,
+    };
 
-    return symtable;
+    return 0;
 }
 
-void symstack_most_local(symstack_t *s)
+int symstack_pop_scope(symstack_t *s)
 {
     assert(s);
 
-    s->act = s->top;
+    struct symstack_scope *scope;
+    struct symstack_binding *binding;
+
+    if (s->scope_count == 0)
+        // Only the global scope is there
+        return -1;
+
+    scope = &s->scopes[--s->scope_count];
+    SYMTABLE_STAT(symtable_stats.scopes_left++);
+
+    // Bindings of the scope are on top, names get their shadowed bindings back
+    while (s->binding_count > scope->bindings) {
+        binding = &s->bindings[--s->binding_count];
+        find_slot(s, binding->identifier->atom)->top = binding->shadowed;
+    }
+
+    // Release identifiers of the scope (blocks stay allocated for the next scopes, data of identifiers
+    // like signatures of functions are stored in the global table)
+    s->current = scope->block;
+    if (s->current)
+        s->current->used = scope->used;
+
+    return 0;
 }
 
-void symstack_next(symstack_t *s)
+size_t symstack_depth(symstack_t *s)
 {
     assert(s);
 
-    if (s->act)
-        s->act = s->act->next;
+    return s->scope_count;
 }
 
-symtable_t *symstack_get(symstack_t *s)
+identifier_t *symstack_find_local(symstack_t *s, const atom_t *atom)
 {
     assert(s);
+    assert(atom);
+
+    struct symstack_slot *slot;
+
+    if (s->scope_count == 0)
+        return symstack_find_global(s, atom);
+
+    // The top binding is in the most-local scope only if it was bound after entering the scope
+    slot = find_slot(s, atom);
+    SYMTABLE_STAT(symtable_stats.local_lookups++);
+    if (slot->top > s->scopes[s->scope_count - 1].bindings) {
+        SYMTABLE_STAT(symtable_stats.local_hits++);
+        return s->bindings[slot->top - 1].identifier;
+    }
+
+    return NULL;
+}
+
+/**
+ * Takes space for a new identifier from symstack's storage
+ *
+ * @param s Pointer to symstack
+ * @return Pointer to zeroed identifier or NULL on allocation failure
+ */
+static identifier_t *create_identifier(symstack_t *s)
+{
+    struct symstack_block *block = s->current;
+    size_t capacity;
+
+    // Storage starts with the first block (it's reused after leaving of all scopes)
+    if (!block && s->blocks) {
+        block = s->blocks;
+        block->used = 0;
+    }
+
+    // Block is full, so the following one is used (or a new one is allocated)
+    if (!block || block->used == block->capacity) {
+        if (block && block->next) {
+            block = block->next;
+        } else {
+            capacity = block ? block->capacity * 2 : SYMSTACK_INITIAL_BLOCK;
+            struct symstack_block *new_block = malloc(
+                    sizeof(struct symstack_block) + capacity * sizeof(identifier_t)
+            );
+            if (!new_block)
+                return NULL;
+
+            new_block->next = NULL;
+            new_block->capacity = capacity;
+            if (block)
+                block->next = new_block;
+            else
+                s->blocks = new_block;
+            block = new_block;
+        }
+
+        block->used = 0;
+    }
+
+    s->current = block;
+
+    identifier_t *id = &block->identifiers[block->used++];
+    memset(id, 0, sizeof(identifier_t));
 
-    if (s->act)
-        return s->act->item;
-    else
+    return id;
+}
+
+identifier_t *symstack_add_local(symstack_t *s, const atom_t *atom)
+{
+    assert(s);
+    assert(atom);
+
+    struct symstack_slot *slot;
+    struct symstack_binding *bindings;
+    size_t capacity;
+    identifier_t *id;
+
+    if (s->scope_count == 0) {
+        // Builtin functions are never added to the global table
+        id = symstack_find_global(s, atom);
+        return id ? id : symtable_add_atom(s->global, atom);
+    }
+
+    id = symstack_find_local(s, atom);
+    if (id)
+        return id;
+
+    // Keep the map at most 3/4 full
+    slot = find_slot(s, atom);
+    if (!slot->atom && 4 * (s->name_count + 1) > 3 * s->slot_count) {
+        if (grow_slots(s) < 0)
+            return NULL;
+
+        slot = find_slot(s, atom);
+    }
+
+    if (s->binding_count == s->binding_cap) {
+        capacity = s->binding_cap * 2;
+        bindings = realloc(s->bindings, capacity * sizeof(struct symstack_binding));
+        if (!bindings)
+            return NULL;
+
+        s->bindings = bindings;
+        s->binding_cap = capacity;
+    }
+
+    id = create_identifier(s);
+    if (!id)
         return NULL;
+
+    id->name = atom->name;
+    id->atom = atom;
+
+    if (!slot->atom) {
+        slot->atom = atom;
+        s->name_count++;
+    }
+
+    SYMTABLE_STAT(symtable_stats.bindings++);
+
+    // New binding shadows the previous one
+    s->bindings[s->binding_count++] = (struct symstack_binding) {id, slot->top};
+    slot->top = s->binding_count;
+
+    return id;
 }
 
-symtable_t *symstack_global_symtable(symstack_t *s)
+identifier_t *symstack_find_variable(symstack_t *s, const atom_t *atom)
 {
     assert(s);
+    assert(atom);
+
+    identifier_t *id;
+    size_t binding = s->scope_count ? find_slot(s, atom)->top : 0;
+#ifdef SYMTABLE_STATS
+    unsigned long chain = 0;
+#endif
+
+    SYMTABLE_STAT(symtable_stats.var_lookups++);
 
-    struct symstack_node *current_node = s->top;
+    // Go through bindings from the most-local one (every scope has at most one binding of the name)
+    while (binding) {
+        SYMTABLE_STAT(symtable_stats.chain_steps++; chain++);
+        SYMTABLE_STAT(if (chain > symtable_stats.max_chain) symtable_stats.max_chain = chain);
 
-    if (!current_node)
-        // Symstack is empty
+        id = s->bindings[binding - 1].identifier;
+        if (id->type == VARIABLE)
+            return id;
+
+        binding = s->bindings[binding - 1].shadowed;
+    }
+
+    id = symtable_find_atom(s->global, atom);
+    if (id && id->type == VARIABLE)
+        return id;
+
+    return NULL;
+}
+
+/**
+ * Finds builtin function (its identifier is copied into the symstack by the first use)
+ *
+ * @param s Pointer to symstack
+ * @param atom Interned name of the function
+ * @return Pointer to the copy of builtin's identifier or NULL if there isn't builtin with the name
+ */
+static identifier_t *find_builtin(symstack_t *s, const atom_t *atom)
+{
+    int index = builtins_find(atom->name, atom->len);
+    if (index < 0)
         return NULL;
 
-    // Find oldest symtable (it's the global one)
-    while (current_node->next != NULL)
-        current_node = current_node->next;
+    // Copy refers to the atom, like identifiers in tables (the table of builtins is constant)
+    if (!s->builtins[index].atom) {
+        s->builtins[index] = *builtins_identifier(index);
+        s->builtins[index].atom = atom;
+        s->builtins[index].name = atom->name;
+    }
 
-    return current_node->item;
+    return &s->builtins[index];
 }
 
-bool symstack_is_active(symstack_t *s)
+identifier_t *symstack_find_global(symstack_t *s, const atom_t *atom)
 {
     assert(s);
+    assert(atom);
+
+    identifier_t *id = symtable_find_atom(s->global, atom);
 
-    return (s->act);
+    return id ? id : find_builtin(s, atom);
+}
+
+symtable_t *symstack_global_symtable(symstack_t *s)
+{
+    assert(s);
+
+    return s->global;
 }
 
 void symstack_destroy(symstack_t *s)
 {
     assert(s);
 
+    struct symstack_block *next;
+
+    while (s->scope_count > 0)
+        symstack_pop_scope(s);
+
+    while (s->blocks) {
+        next = s->blocks->next;
+        free(s->blocks);
+        s->blocks = next;
+    }
+
+    free(s->slots);
+    free(s->bindings);
+    free(s->scopes);
     free(s);
 }
@@ -1,6 +1,6 @@
 /**
  * @file symstack.h
- * Header of stack-like storage for tables of symbols
+ * Header of scoped storage of symbols (global table and nested block scopes)
  *
  * IFJ and IAL project (IFJ21 compiler)
  * Team: 128 (variant II)
@@ -13,127 +13,242 @@
 #define _SYMSTACK_H_
 
 #include "symtable.h"
+#include "builtins.h"
+#include "identifier.h"
+#include "interner.h"
 
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
 /**
- * Stack-like structure is internally implemented as linked-list,
- * so we need to store pointers for next items somewhere.
+ * Initial number of slots of the name map (must be a power of 2)
+ */
+#define SYMSTACK_INITIAL_SLOTS 64
+
+/**
+ * Number of identifiers in the first storage block (next blocks are twice bigger)
+ */
+#define SYMSTACK_INITIAL_BLOCK 64
+
+/**
+ * Initial capacity of the stack of opened block scopes (it's doubled when needed)
+ */
+#define SYMSTACK_INITIAL_SCOPES 16
+
+/**
+ * Initial capacity of the stack of bindings (it's doubled when needed)
+ */
+#define SYMSTACK_INITIAL_BINDINGS 64
+
+/**
+ * Binding of a name in a block scope
  *
- * Pointer to next item points to the more-global table of symbols.
- * The first node is activated by symstack_most_local() function and points
- * to the most-local (currently processed) scope, its `next` pointer
- * points to the previous scope (higher) etc.
+ * Bindings of all block scopes form one stack (it's the undo log of scopes too).
+ *
+ * identifier  identifier bound to the name in the scope
+ * shadowed    binding of the same name in an outer scope (index + 1, 0 if there isn't any)
+ */
+struct symstack_binding {
+    identifier_t *identifier;
+    size_t shadowed;
+};
+
+/**
+ * Slot of the map from names to their bindings
+ *
+ * Slots are never removed (empty binding stack is marked by zero top).
+ *
+ * atom  interned name (NULL in empty slot)
+ * top   the most-local binding of the name (index + 1, 0 if the name isn't bound in any block scope)
  */
-struct symstack_node {
-    symtable_t *item;
-    struct symstack_node *next;
+struct symstack_slot {
+    const atom_t *atom;
+    size_t top;
 };
 
 /**
- * Stack-like structure for storing tables of symbols implemented as linked list
- * It's realized throw top and active pointers. Active pointer (structure's "list
- * part") is set by symstack_most_local() and symstack_next() functions. Top is the top
- * of the "stack part" of the structure.
+ * Block of storage for identifiers of block scopes
+ *
+ * Blocks are kept after leaving scopes and reused by the next ones.
+ *
+ * next         the following block
+ * used         number of identifiers in the block
+ * capacity     maximal number of identifiers in the block
+ * identifiers  stored identifiers
+ */
+struct symstack_block {
+    struct symstack_block *next;
+    size_t used;
+    size_t capacity;
+    identifier_t identifiers[];
+};
+
+/**
+ * Opened block scope
+ *
+ * bindings  number of bindings when the scope was entered
+ * block     storage block in use when the scope was entered
+ * used      number of used identifiers of the block when the scope was entered
+ */
+struct symstack_scope {
+    size_t bindings;
+    struct symstack_block *block;
+    size_t used;
+};
+
+/**
+ * Scoped storage of symbols
+ *
+ * Global symbols are stored in a table of symbols (builtin functions are in
+ * the constant table of builtins, the symstack has their copies with atoms). Every name used in block scopes
+ * has a stack of bindings (the most-local one is on top), so lookup doesn't depend
+ * on the depth of nesting. Leaving a scope only pops its bindings.
+ *
+ * Scopes are kept in a growable array (the global scope is the bottom of it),
+ * so entering and leaving a scope and access to the global table are O(1)
+ * and they don't allocate anything until the initial capacities are exceeded.
+ *
+ * global          table of global symbols (it isn't owned by the symstack)
+ * slots           map from names to their bindings
+ * slot_count      number of slots (power of 2)
+ * name_count      number of used slots
+ * bindings        stack of bindings of all block scopes
+ * binding_count   number of bindings
+ * binding_cap     capacity of the bindings stack
+ * scopes          stack of opened block scopes
+ * scope_count     number of opened block scopes (the global scope isn't included)
+ * scope_cap       capacity of the scopes stack
+ * blocks          the first block of identifiers' storage
+ * current         block used for new identifiers
+ * builtins        copies of used builtin functions' identifiers (indexed like the table of builtins)
  */
 struct symstack {
-    struct symstack_node *top;
-    struct symstack_node *act;
+    symtable_t *global;
+    struct symstack_slot *slots;
+    size_t slot_count;
+    size_t name_count;
+    struct symstack_binding *bindings;
+    size_t binding_count;
+    size_t binding_cap;
+    struct symstack_scope *scopes;
+    size_t scope_count;
+    size_t scope_cap;
+    struct symstack_block *blocks;
+    struct symstack_block *current;
+    identifier_t builtins[NUMBER_OF_BUILTINS];
 };
 
 /**
- * Stack-like ADT for storing pointers to tables of symbols
+ * Scoped ADT for storing symbols
  */
 typedef struct symstack symstack_t;
 
 /**
- * Creates a new stack-like structure for storing symtable records (symstack)
+ * Creates a new scoped storage of symbols with only the global scope
  *
- * @return Pointer to created symstack
+ * @param global Table of global symbols (it has to be destroyed by the caller after the symstack)
+ * @return Pointer to created symstack or NULL if error occurred
+ *
+ * @pre global != NULL
  */
- symstack_t *symstack_create(void);
+symstack_t *symstack_create(symtable_t *global);
 
 /**
- * Pushes new table of symbols to the top of the "stack"
+ * Enters a new (the most-local) block scope
  *
  * @param s Pointer to symstack
- * @param symtable Pointer to symtable_t to be pushed
- * @return 0 on successful push, negative value otherwise
+ * @return 0 on success, negative value otherwise
  *
  * @pre s != NULL
- * @pre symtable != NULL
  */
-int symstack_push(symstack_t *s, symtable_t *symtable);
+int symstack_push_scope(symstack_t *s);
 
 /**
- * Takes out the table of symbols on the top of the "stack"
- *
- * This function deletes the table pointer from the symstack!
+ * Leaves the most-local block scope (identifiers of the scope are released)
  *
  * @param s Pointer to symstack
- * @return Symbols table on the top of the "stack" or NULL if it's empty
+ * @return 0 on success, negative value if there is only the global scope
  *
  * @pre s != NULL
  */
-symtable_t *symstack_pop(symstack_t *s);
+int symstack_pop_scope(symstack_t *s);
 
 /**
- * Sets the most-local symbols table on the top of "stack" as active
+ * Returns number of opened block scopes
  *
  * @param s Pointer to symstack
+ * @return Depth of the most-local scope (0 is the global one)
  *
  * @pre s != NULL
  */
-void symstack_most_local(symstack_t *s);
+size_t symstack_depth(symstack_t *s);
 
 /**
- * Sets the more-global symbols table as active
+ * Tries to find an identifier in the most-local scope
  *
  * @param s Pointer to symstack
+ * @param atom Interned name of the identifier
+ * @return Pointer to the identifier or NULL if the name isn't in the most-local scope
  *
- * @pre s != NULL
+ * @pre s != NULL && atom != NULL
  */
-void symstack_next(symstack_t *s);
+identifier_t *symstack_find_local(symstack_t *s, const atom_t *atom);
 
 /**
- * Returns active symtable
+ * Adds an identifier to the most-local scope if it is not already present
  *
  * @param s Pointer to symstack
- * @return Pointer to the active symtable or NULL if no symtable is active
+ * @param atom Interned name of the identifier
+ * @return Pointer to the already present or newly added identifier or NULL on allocation failure
  *
- * @pre s != NULL
+ * @pre s != NULL && atom != NULL
  */
-symtable_t *symstack_get(symstack_t *s);
+identifier_t *symstack_add_local(symstack_t *s, const atom_t *atom);
 
 /**
- * Returns global symtable stored in the symstack
+ * Finds the most-local variable with the name
+ *
+ * Scopes are searched from the most-local one to the global one, identifiers
+ * without VARIABLE type are skipped.
  *
  * @param s Pointer to symstack
- * @return Global symtable or NULL if symstack is empty
+ * @param atom Interned name of the variable
+ * @return Pointer to the variable or NULL if there isn't any
  *
- * @pre s != NULL
+ * @pre s != NULL && atom != NULL
  */
-symtable_t *symstack_global_symtable(symstack_t *s);
+identifier_t *symstack_find_variable(symstack_t *s, const atom_t *atom);
 
 /**
- * Checks if the activity flag is set to one of stored tables of symbols
+ * Tries to find an identifier in the global scope
+ *
+ * Global table of symbols and builtin functions are searched.
  *
  * @param s Pointer to symstack
- * @return Is there any active node?
+ * @param atom Interned name of the identifier
+ * @return Pointer to the identifier or NULL if the name isn't in the global scope
+ *
+ * @pre s != NULL && atom != NULL
+ */
+identifier_t *symstack_find_global(symstack_t *s, const atom_t *atom);
+
+/**
+ * Returns global symtable stored in the symstack
+ *
+ * @param s Pointer to symstack
+ * @return Global symtable
  *
  * @pre s != NULL
  */
-bool symstack_is_active(symstack_t *s);
+symtable_t *symstack_global_symtable(symstack_t *s);
 
 /**
- * Destroys empty symstack
+ * Destroys symstack (opened block scopes are left)
  *
  * @param s Symstack to be destroyed
  *
  * @pre s != NULL
- * @pre symstack_most_local(s); symstack_is_active(s) == false
  */
 void symstack_destroy(symstack_t *s);
 
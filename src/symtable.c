@@ -6,6 +6,7 @@
  * Team: 128 (variant II)
  *
  * @author Martin Havlík (xhavli56)
+ * @author Michal Šmahel (xsmahe01)
  */
 #include "symtable.h"
 
@@ -16,61 +17,499 @@
 #include <stdlib.h>
 #include <string.h>
 
-symtable_t *symtable_create(void)
+// Groups of control bytes are compared by SSE2 instructions if they're available
+#if defined(SYMTABLE_SWISS) && defined(__SSE2__)
+#define SYMTABLE_SIMD_GROUP
+#include <emmintrin.h>
+#endif
+
+#ifdef SYMTABLE_SWISS
+
+/**
+ * Control byte of an empty slot (control bytes of used slots have the highest bit clear)
+ */
+#define CTRL_EMPTY 0x80
+
+/**
+ * Control byte of a used slot (the highest 7 bits of the hash, the lowest ones select the first slot)
+ */
+#define CTRL_HASH(hash) ((uint8_t) ((hash) >> 25))
+
+/**
+ * Finds control bytes with the given value in the group
+ *
+ * @param ctrl The first control byte of the group
+ * @param byte Searched value
+ * @return Mask with bit set for every matching control byte
+ */
+static unsigned group_match(const uint8_t *ctrl, uint8_t byte)
+{
+#ifdef SYMTABLE_SIMD_GROUP
+    __m128i group = _mm_loadu_si128((const __m128i *) ctrl);
+
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) byte)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < SYMTABLE_GROUP_WIDTH; i++) {
+        if (ctrl[i] == byte)
+            mask |= 1u << i;
+    }
+
+    return mask;
+#endif
+}
+
+/**
+ * Returns position of the lowest set bit of non-zero mask
+ *
+ * @param mask Mask to check
+ * @return Index of the bit
+ */
+static unsigned lowest_bit(unsigned mask)
+{
+#ifdef __GNUC__
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        i++;
+    }
+
+    return i;
+#endif
+}
+
+/**
+ * Allocates empty slots and their control bytes
+ *
+ * @param capacity Number of slots (power of 2, at least SYMTABLE_GROUP_WIDTH)
+ * @param slots Allocated slots
+ * @param ctrl Allocated control bytes
+ * @return Were slots successfully allocated?
+ */
+static bool alloc_slots(size_t capacity, struct symtable_slot **slots, uint8_t **ctrl)
+{
+    *slots = calloc(capacity, sizeof(struct symtable_slot));
+    *ctrl = malloc(capacity + SYMTABLE_GROUP_WIDTH);
+    if (!*slots || !*ctrl) {
+        free(*slots);
+        free(*ctrl);
+        return false;
+    }
+
+    memset(*ctrl, CTRL_EMPTY, capacity + SYMTABLE_GROUP_WIDTH);
+
+    return true;
+}
+
+/**
+ * Fills the empty slot
+ *
+ * @param t Table with the slot
+ * @param i Index of the slot
+ * @param slot New content of the slot
+ */
+static void fill_slot(symtable_t *t, size_t i, struct symtable_slot slot)
+{
+    t->slots[i] = slot;
+    t->ctrl[i] = CTRL_HASH(slot.hash);
+
+    // Groups starting at the end of the table continue with the first slots
+    if (i < SYMTABLE_GROUP_WIDTH)
+        t->ctrl[t->capacity + i] = CTRL_HASH(slot.hash);
+}
+
+/**
+ * Finds slot of the interned name (the one with its identifier or the empty one, where it belongs)
+ *
+ * @param t Table to search in
+ * @param atom Interned name
+ * @return Index of the slot
+ */
+static size_t find_slot(const symtable_t *t, const atom_t *atom)
+{
+    size_t mask = t->capacity - 1;
+    size_t group = atom->hash & mask;
+    unsigned matches;
+    size_t i;
+
+    // Slots are filled in probing order and never emptied, so a group with empty slot ends probing
+    while (true) {
+        matches = group_match(&t->ctrl[group], CTRL_HASH(atom->hash));
+        while (matches) {
+            i = (group + lowest_bit(matches)) & mask;
+            if (t->slots[i].hash == atom->hash && t->slots[i].identifier->atom == atom)
+                return i;
+
+            matches &= matches - 1;
+        }
+
+        matches = group_match(&t->ctrl[group], CTRL_EMPTY);
+        if (matches)
+            return (group + lowest_bit(matches)) & mask;
+
+        group = (group + SYMTABLE_GROUP_WIDTH) & mask;
+    }
+}
+
+/**
+ * Finds slot of the name (the one with its identifier or the empty one, where it belongs)
+ *
+ * @param t Table to search in
+ * @param name Name to search for
+ * @param len Length of the name
+ * @param hash Hash of the name
+ * @return Index of the slot
+ */
+static size_t find_name_slot(const symtable_t *t, const char *name, size_t len, uint32_t hash)
+{
+    size_t mask = t->capacity - 1;
+    size_t group = hash & mask;
+    unsigned matches;
+    size_t i;
+
+    while (true) {
+        matches = group_match(&t->ctrl[group], CTRL_HASH(hash));
+        while (matches) {
+            i = (group + lowest_bit(matches)) & mask;
+            if (t->slots[i].hash == hash && t->slots[i].len == len
+                && memcmp(t->slots[i].identifier->name, name, len) == 0)
+                return i;
+
+            matches &= matches - 1;
+        }
+
+        matches = group_match(&t->ctrl[group], CTRL_EMPTY);
+        if (matches)
+            return (group + lowest_bit(matches)) & mask;
+
+        group = (group + SYMTABLE_GROUP_WIDTH) & mask;
+    }
+}
+
+/**
+ * Finds the empty slot for the hash (name mustn't be in the table)
+ *
+ * @param t Table to search in
+ * @param hash Hash of the name
+ * @return Index of the slot
+ */
+static size_t find_empty_slot(const symtable_t *t, uint32_t hash)
+{
+    size_t mask = t->capacity - 1;
+    size_t group = hash & mask;
+    unsigned matches;
+
+    while (!(matches = group_match(&t->ctrl[group], CTRL_EMPTY)))
+        group = (group + SYMTABLE_GROUP_WIDTH) & mask;
+
+    return (group + lowest_bit(matches)) & mask;
+}
+
+#else
+
+/**
+ * Allocates empty slots
+ *
+ * @param capacity Number of slots (power of 2)
+ * @param slots Allocated slots
+ * @return Were slots successfully allocated?
+ */
+static bool alloc_slots(size_t capacity, struct symtable_slot **slots)
+{
+    *slots = calloc(capacity, sizeof(struct symtable_slot));
+
+    return *slots != NULL;
+}
+
+/**
+ * Fills the empty slot
+ *
+ * @param t Table with the slot
+ * @param i Index of the slot
+ * @param slot New content of the slot
+ */
+static void fill_slot(symtable_t *t, size_t i, struct symtable_slot slot)
+{
+    t->slots[i] = slot;
+}
+
+/**
+ * Finds slot of the interned name (the one with its identifier or the empty one, where it belongs)
+ *
+ * @param t Table to search in
+ * @param atom Interned name
+ * @return Index of the slot
+ */
+static size_t find_slot(const symtable_t *t, const atom_t *atom)
+{
+    size_t mask = t->capacity - 1;
+    size_t i = atom->hash & mask;
+    struct symtable_slot *slot;
+
+    // Identifier is touched only when hashes match (names are interned, so atoms can be compared directly)
+    for (slot = &t->slots[i]; slot->identifier; slot = &t->slots[i]) {
+        if (slot->hash == atom->hash && slot->identifier->atom == atom)
+            break;
+
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+/**
+ * Finds slot of the name (the one with its identifier or the empty one, where it belongs)
+ *
+ * @param t Table to search in
+ * @param name Name to search for
+ * @param len Length of the name
+ * @param hash Hash of the name
+ * @return Index of the slot
+ */
+static size_t find_name_slot(const symtable_t *t, const char *name, size_t len, uint32_t hash)
+{
+    size_t mask = t->capacity - 1;
+    size_t i = hash & mask;
+    struct symtable_slot *slot;
+
+    // Names are compared only when hashes and lengths match
+    for (slot = &t->slots[i]; slot->identifier; slot = &t->slots[i]) {
+        if (slot->hash == hash && slot->len == len && memcmp(slot->identifier->name, name, len) == 0)
+            break;
+
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+/**
+ * Finds the empty slot for the hash (name mustn't be in the table)
+ *
+ * @param t Table to search in
+ * @param hash Hash of the name
+ * @return Index of the slot
+ */
+static size_t find_empty_slot(const symtable_t *t, uint32_t hash)
+{
+    size_t mask = t->capacity - 1;
+    size_t i = hash & mask;
+
+    while (t->slots[i].identifier)
+        i = (i + 1) & mask;
+
+    return i;
+}
+
+#endif
+
+#ifdef SYMTABLE_STATS
+struct symtable_stats symtable_stats;
+
+/**
+ * Counts lookup into statistics
+ *
+ * Length of probing is computed from distance of the final slot and the first probed one,
+ * so probing itself isn't slowed down.
+ *
+ * @param t Table, which was searched
+ * @param hash Hash of the searched name
+ * @param i Index of the final slot
+ */
+static void count_lookup(const symtable_t *t, uint32_t hash, size_t i)
+{
+    size_t length = (i - hash) & (t->capacity - 1);
+
+#ifdef SYMTABLE_SWISS
+    length = length / SYMTABLE_GROUP_WIDTH + 1;
+#else
+    length = length + 1;
+#endif
+
+    symtable_stats.lookups++;
+    if (t->slots[i].identifier)
+        symtable_stats.hits++;
+    else
+        symtable_stats.misses++;
+
+    symtable_stats.probes += length;
+    if (length > symtable_stats.max_probe)
+        symtable_stats.max_probe = length;
+    symtable_stats.histogram[length < SYMTABLE_STATS_BUCKETS ? length - 1 : SYMTABLE_STATS_BUCKETS - 1]++;
+}
+
+/**
+ * Computes ratio of two counters
+ *
+ * @param part Counted part
+ * @param total Total count
+ * @return Ratio (0 if total is 0)
+ */
+static double stats_ratio(unsigned long part, unsigned long total)
 {
-    symtable_t *t = calloc(1,
-            sizeof(size_t) +
-            sizeof(size_t) +
-            SYMTABLE_BUCKETS * sizeof(uintptr_t));
+    return total ? (double) part / total : 0.0;
+}
+
+void symtable_stats_print(FILE *file)
+{
+    struct symtable_stats *st = &symtable_stats;
+
+    fprintf(file, "Tables of symbols:\n");
+    fprintf(file, "  created: %lu, destroyed: %lu, grown: %lu, inserted identifiers: %lu\n",
+            st->tables_created, st->tables_destroyed, st->grows, st->inserts);
+    fprintf(file, "  lookups: %lu, hits: %lu (%.1f %%), misses: %lu\n",
+            st->lookups, st->hits, 100 * stats_ratio(st->hits, st->lookups), st->misses);
+#ifdef SYMTABLE_SWISS
+    fprintf(file, "  probed groups: %lu, average: %.2f, maximum: %lu\n",
+#else
+    fprintf(file, "  probed slots: %lu, average: %.2f, maximum: %lu\n",
+#endif
+            st->probes, stats_ratio(st->probes, st->lookups), st->max_probe);
+    fprintf(file, "  lookups by probe length:\n");
+    for (int i = 0; i < SYMTABLE_STATS_BUCKETS; i++) {
+        if (st->histogram[i])
+            fprintf(file, "    %2d%s %10lu\n", i + 1, i == SYMTABLE_STATS_BUCKETS - 1 ? "+" : " ", st->histogram[i]);
+    }
 
+    fprintf(file, "Block scopes:\n");
+    fprintf(file, "  entered: %lu, left: %lu, maximal depth: %lu, tables created per scope: %.2f\n",
+            st->scopes_entered, st->scopes_left, st->max_depth,
+            stats_ratio(st->tables_created, st->scopes_entered));
+    fprintf(file, "  local lookups: %lu, hits: %lu (%.1f %%), bindings: %lu\n",
+            st->local_lookups, st->local_hits, 100 * stats_ratio(st->local_hits, st->local_lookups), st->bindings);
+    fprintf(file, "  variable lookups: %lu, checked bindings: %lu, average: %.2f, maximum: %lu\n",
+            st->var_lookups, st->chain_steps, stats_ratio(st->chain_steps, st->var_lookups), st->max_chain);
+}
+#endif
+
+symtable_t *symtable_create(void)
+{
+    symtable_t *t = malloc(sizeof(symtable_t));
     if (!t)
         return NULL;
 
+    // Initialize all slots to NULL (empty)
+#ifdef SYMTABLE_SWISS
+    if (!alloc_slots(SYMTABLE_INITIAL_CAPACITY, &t->slots, &t->ctrl)) {
+#else
+    if (!alloc_slots(SYMTABLE_INITIAL_CAPACITY, &t->slots)) {
+#endif
+        free(t);
+        return NULL;
+    }
+
     t->size = 0;
-    t->buckets = SYMTABLE_BUCKETS;
+    t->capacity = SYMTABLE_INITIAL_CAPACITY;
+    t->blocks = NULL;
+    t->arena = NULL;
+    t->current = NULL;
+    t->interner = NULL;
+    SYMTABLE_STAT(symtable_stats.tables_created++);
 
-    // Initialize all pointers to items to NULL
-    for (int i = 0; i < SYMTABLE_BUCKETS; i++)
-        t->items[i] = NULL;
+    return t;
+}
+
+/**
+ * Allocates a new chunk of arena
+ *
+ * @param capacity Size of data in bytes
+ * @return Pointer to the chunk or NULL on allocation failure
+ */
+static struct symtable_chunk *create_chunk(size_t capacity)
+{
+    struct symtable_chunk *chunk = malloc(sizeof(struct symtable_chunk) + capacity);
+    if (!chunk)
+        return NULL;
+
+    chunk->next = NULL;
+    chunk->used = 0;
+    chunk->capacity = capacity;
+
+    return chunk;
+}
+
+symtable_t *symtable_create_arena(void)
+{
+    symtable_t *t = symtable_create();
+    if (!t)
+        return NULL;
+
+    t->arena = create_chunk(SYMTABLE_ARENA_CHUNK);
+    if (!t->arena) {
+        symtable_destroy(t);
+        return NULL;
+    }
+    t->current = t->arena;
 
     return t;
 }
 
-size_t symtable_bucket_count(const symtable_t *t)
+/**
+ * Bump-allocates space in table's arena
+ *
+ * @param t Table with arena
+ * @param size Number of bytes to allocate
+ * @return Pointer to the space (aligned for any type) or NULL on allocation failure
+ */
+static void *arena_alloc(symtable_t *t, size_t size)
 {
-    return *(((size_t *) t) + 1);
+    struct symtable_chunk *chunk = t->current;
+    size_t capacity;
+    void *space;
+
+    // Every allocation is aligned for any type
+    size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+
+    // Chunk is full, so the following one is used (or a new one is allocated)
+    while (chunk->capacity - chunk->used < size) {
+        if (!chunk->next) {
+            capacity = chunk->capacity * 2;
+            while (capacity < size)
+                capacity *= 2;
+
+            chunk->next = create_chunk(capacity);
+            if (!chunk->next)
+                return NULL;
+        }
+
+        chunk = chunk->next;
+        chunk->used = 0;
+    }
+
+    t->current = chunk;
+    space = (unsigned char *) chunk->data + chunk->used;
+    chunk->used += size;
+
+    return space;
 }
 
 void symtable_clear(symtable_t *t)
 {
     assert(t);
 
-    size_t buckets = symtable_bucket_count(t);
-    symtable_item_t *item = NULL;
-    symtable_item_t *next = NULL;
+    struct symtable_block *block = t->blocks;
+    struct symtable_block *next;
 
-    // Go through all buckets
-    for (unsigned int i = 0; i < buckets; i++) {
-
-        item = t->items[i];
-        if (!item) // Bucket is empty, continue to next one
-            continue;
-
-        do { // Traverse non empty bucket and free all items
-            next = item->next;
-            free((char *)item->identifier.name);
-            if (item->identifier.type == FUNCTION) {
-                if (item->identifier.fun.param)
-                    free(item->identifier.fun.param);
-                if (item->identifier.fun.retval)
-                    free(item->identifier.fun.retval);
-            }
-            free(item);
-            item = next;
+    // Identifiers don't own any data (signatures are stored inline), so only blocks are freed
+    while (block) {
+        next = block->next;
+        free(block);
+        block = next;
+    }
 
-        } while (item);
-        t->items[i] = NULL;
+    // Everything in arena is released at once
+    if (t->arena) {
+        t->arena->used = 0;
+        t->current = t->arena;
     }
+
+    memset(t->slots, 0, t->capacity * sizeof(struct symtable_slot));
+#ifdef SYMTABLE_SWISS
+    memset(t->ctrl, CTRL_EMPTY, t->capacity + SYMTABLE_GROUP_WIDTH);
+#endif
+    t->blocks = NULL;
     t->size = 0;
 }
 
@@ -78,132 +517,193 @@ void symtable_destroy(symtable_t *t)
 {
     assert(t);
 
+    struct symtable_chunk *next;
+
+    SYMTABLE_STAT(symtable_stats.tables_destroyed++);
     symtable_clear(t);
+    while (t->arena) {
+        next = t->arena->next;
+        free(t->arena);
+        t->arena = next;
+    }
+
+    if (t->interner)
+        interner_destroy(t->interner);
+
+    free(t->slots);
+#ifdef SYMTABLE_SWISS
+    free(t->ctrl);
+#endif
     free(t);
 }
 
-// Source: http://isthe.com/chongo/tech/comp/fnv/ (FNV-1a)
-#define OFFSET_BASIS 2166136261
-#define FNV_PRIME 16777619
-size_t symtable_hash_function(const char *str)
+identifier_t *symtable_find_atom(symtable_t *t, const atom_t *atom)
 {
-    uint32_t h = OFFSET_BASIS;
-    const unsigned char *p;
-    for (p = (const unsigned char *) str; *p != '\0'; p++) {
-        h ^= *p;
-        h *= FNV_PRIME;
-    }
+    assert(t);
+    assert(atom);
 
-    return h;
+    size_t i = find_slot(t, atom);
+
+    SYMTABLE_STAT(count_lookup(t, atom->hash, i));
+
+    // Empty slot means the name isn't in the table
+    return t->slots[i].identifier;
 }
 
-identifier_t *symtable_find(symtable_t *t, char *name)
+identifier_t *symtable_find(symtable_t *t, const char *name)
 {
     assert(t);
     assert(name);
 
-    size_t buckets = symtable_bucket_count(t);
-    size_t hash = symtable_hash_function(name);
-    symtable_item_t *item;
+    size_t len = strlen(name);
+    uint32_t hash = interner_hash(name, len);
+    size_t i = find_name_slot(t, name, len, hash);
 
-    // Get the first item in correct bucket
-    item = t->items[hash % buckets];
-    if (!item)
-        return NULL;
+    SYMTABLE_STAT(count_lookup(t, hash, i));
 
-    // If names match, return the identifier
-    if (!strcmp(item->identifier.name, name))
-        return &item->identifier;
-
-    // Else traverse the bucket and try to find it
-    item = item->next;
-    while (item) {
-        if (!strcmp(item->identifier.name, name))
-            return &item->identifier; // return if found
+    return t->slots[i].identifier;
+}
 
-        item = item->next;
+/**
+ * Doubles the number of table's slots
+ *
+ * @param t Table to grow
+ * @return Was the table successfully grown?
+ */
+static bool grow_slots(symtable_t *t)
+{
+    struct symtable_slot *old_slots = t->slots;
+    size_t old_capacity = t->capacity;
+
+#ifdef SYMTABLE_SWISS
+    uint8_t *old_ctrl = t->ctrl;
+    if (!alloc_slots(old_capacity * 2, &t->slots, &t->ctrl)) {
+        t->slots = old_slots;
+        t->ctrl = old_ctrl;
+        return false;
     }
+    free(old_ctrl);
+#else
+    if (!alloc_slots(old_capacity * 2, &t->slots)) {
+        t->slots = old_slots;
+        return false;
+    }
+#endif
+    t->capacity = old_capacity * 2;
+    SYMTABLE_STAT(symtable_stats.grows++);
+
+    // Move slots by their stored hashes (names are unique, so only empty slot is needed)
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].identifier)
+            fill_slot(t, find_empty_slot(t, old_slots[i].hash), old_slots[i]);
+    }
+
+    free(old_slots);
 
-    return NULL;
+    return true;
 }
 
-symtable_item_t *create_item(char *name)
+/**
+ * Takes space for a new identifier from table's storage
+ *
+ * @param t Table with the storage
+ * @return Pointer to zeroed identifier or NULL on allocation failure
+ */
+static identifier_t *create_identifier(symtable_t *t)
 {
-    assert(name);
+    struct symtable_block *block = t->blocks;
+    size_t capacity;
+    identifier_t *id;
 
-    size_t name_len;
-    symtable_item_t *item;
+    if (t->arena) {
+        id = arena_alloc(t, sizeof(identifier_t));
+        if (id)
+            memset(id, 0, sizeof(identifier_t));
 
-    // Allocate space on heap for item
-    item = calloc(1, sizeof(symtable_item_t));
-    if (!item)
-        return NULL;
+        return id;
+    }
 
-    // Allocate space on heap for name
-    name_len = strlen(name) + 1; // Include '\0'
-    item->identifier.name = calloc(1, name_len);
-    if (!item->identifier.name) {
-        free(item);
-        return NULL;
+    // The newest block is full, so the next one is needed
+    if (!block || block->used == block->capacity) {
+        capacity = block ? block->capacity * 2 : SYMTABLE_INITIAL_BLOCK;
+        block = malloc(sizeof(struct symtable_block) + capacity * sizeof(identifier_t));
+        if (!block)
+            return NULL;
+
+        block->next = t->blocks;
+        block->used = 0;
+        block->capacity = capacity;
+        t->blocks = block;
     }
 
-    // Copy name to the allocated space and set initial properties of the identifier
-    strncpy((char *) item->identifier.name, name, name_len);
-    item->identifier.line = 0;
-    item->identifier.character = 0;
-    item->identifier.var = (struct variable){0, };
-    item->next = NULL;
-    return item;
+    id = &block->identifiers[block->used++];
+    memset(id, 0, sizeof(identifier_t));
+
+    return id;
 }
 
-identifier_t *symtable_add(symtable_t *t, char *name)
+identifier_t *symtable_add_atom(symtable_t *t, const atom_t *atom)
 {
     assert(t);
-    assert(name);
-
-    size_t buckets = symtable_bucket_count(t);
-    size_t hash = symtable_hash_function(name);
-    symtable_item_t *item;
-    symtable_item_t *next;
+    assert(atom);
 
-    // Work in correct bucket as calculated by hash function
-    item = t->items[hash % buckets];
-    next = item;
+    size_t i = find_slot(t, atom);
+    identifier_t *id;
 
-    if (!item) { // Bucket is empty, need to create new item and add it
+    // Name in identifier matches given name
+    if (t->slots[i].identifier)
+        return t->slots[i].identifier;
 
-        item = create_item(name);
-        if (!item)
+    // Keep the table at most 3/4 full (slot of the new identifier changes with the table)
+    if (4 * (t->size + 1) > 3 * t->capacity) {
+        if (!grow_slots(t))
             return NULL;
 
-        // Adding new item to table
-        t->items[hash % buckets] = item;
+        i = find_slot(t, atom);
+    }
 
-        // Increment current size and return pointer to created identifier
-        t->size++;
-        return &item->identifier;
+    id = create_identifier(t);
+    if (!id)
+        return NULL;
 
-    }
-    // Items exists or hashes to non empty bucket,
-    // Traverse bucket and return it or append a new one
-    do {
-        item = next;
+    // Name is shared with the interner and set initial properties of the identifier
+    id->name = atom->name;
+    id->atom = atom;
+    id->line = 0;
+    id->character = 0;
+    id->var = (struct variable){0, };
 
-        // Name in identifier matches given name
-        if (!strcmp(item->identifier.name, name))
-            return &item->identifier;
+    SYMTABLE_STAT(symtable_stats.inserts++);
 
-        next = item->next;
-    } while (next);
+    // Increment current size and return pointer to created identifier
+    fill_slot(t, i, (struct symtable_slot) {id, atom->hash, (uint32_t) atom->len});
+    t->size++;
 
-    // Traversed bucket, not found the item, need to create and append it
+    return id;
+}
+
+identifier_t *symtable_add(symtable_t *t, const char *name)
+{
+    assert(t);
+    assert(name);
+
+    size_t len = strlen(name);
+    size_t i = find_name_slot(t, name, len, interner_hash(name, len));
+    const atom_t *atom;
 
-    item->next = create_item(name);
-    if (!item->next)
+    // Name is already in the table (its atom may be from another interner)
+    if (t->slots[i].identifier)
+        return t->slots[i].identifier;
+
+    if (!t->interner) {
+        t->interner = interner_create();
+        if (!t->interner)
+            return NULL;
+    }
+
+    atom = interner_intern(t->interner, name, len);
+    if (!atom)
         return NULL;
 
-    // Increment current size and return pointer to created identifier
-    t->size += 1;
-    return &item->next->identifier;
+    return symtable_add_atom(t, atom);
 }
-
@@ -6,39 +6,208 @@
  * Team: 128 (variant II)
  *
  * @author Martin Havlík (xhavli56)
+ * @author Michal Šmahel (xsmahe01)
  */
 #ifndef _SYMTABLE_H_
 #define _SYMTABLE_H_
 
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdint.h>
 
 #include "identifier.h"
+#include "interner.h"
 
-#define SYMTABLE_BUCKETS 23
+/**
+ * Initial number of slots of a table (must be a power of 2)
+ */
+#define SYMTABLE_INITIAL_CAPACITY 16
+
+/**
+ * Number of identifiers in the first storage block (next blocks are twice bigger)
+ */
+#define SYMTABLE_INITIAL_BLOCK 8
+
+/**
+ * Size of the first arena chunk in bytes (next chunks are twice bigger)
+ */
+#define SYMTABLE_ARENA_CHUNK 4096
+
+/**
+ * Probing of slots (compile with -DSYMTABLE_SWISS to select the control-byte one)
+ *
+ * Default probing checks slots one by one. The alternative one keeps a control
+ * byte per slot (7 bits of the hash or empty mark) and checks whole groups
+ * of SYMTABLE_GROUP_WIDTH control bytes at once (with SSE2 if it's available).
+ */
+#ifdef SYMTABLE_SWISS
+/**
+ * Number of control bytes checked at once
+ */
+#define SYMTABLE_GROUP_WIDTH 16
+#endif
 
 /**
  * Symbol table abstract data type.
  */
 typedef struct symtable symtable_t;
 
-typedef struct symtable_item {
-    identifier_t identifier;
-    struct symtable_item *next;
-} symtable_item_t;
+/**
+ * Statistics of tables of symbols and scopes (compile with -DSYMTABLE_STATS to collect them)
+ *
+ * Without SYMTABLE_STATS the counting statements aren't compiled at all.
+ */
+#ifdef SYMTABLE_STATS
+/**
+ * Number of buckets of probe length histogram (the last one counts longer probing, too)
+ */
+#define SYMTABLE_STATS_BUCKETS 16
+
+/**
+ * Counters of symbol machinery.
+ *
+ * lookups           number of lookups in tables (symtable_find() and symtable_find_atom())
+ * hits              number of successful lookups
+ * misses            number of unsuccessful lookups
+ * probes            number of slots (groups with SYMTABLE_SWISS) checked by lookups
+ * max_probe         the longest probing of lookup
+ * histogram         number of lookups by probe length (index is length - 1)
+ * inserts           number of identifiers added to tables
+ * grows             number of growths of tables' slots
+ * tables_created    number of created tables
+ * tables_destroyed  number of destroyed tables
+ * scopes_entered    number of entered block scopes
+ * scopes_left       number of left block scopes
+ * max_depth         the deepest nesting of block scopes
+ * local_lookups     number of lookups in the most-local block scope
+ * local_hits        number of successful lookups in the most-local block scope
+ * bindings          number of bindings created in block scopes
+ * var_lookups       number of lookups of variables through scopes
+ * chain_steps       number of bindings checked by lookups of variables
+ * max_chain         the longest chain of bindings checked by lookup of variable
+ */
+struct symtable_stats {
+    unsigned long lookups;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long probes;
+    unsigned long max_probe;
+    unsigned long histogram[SYMTABLE_STATS_BUCKETS];
+    unsigned long inserts;
+    unsigned long grows;
+    unsigned long tables_created;
+    unsigned long tables_destroyed;
+    unsigned long scopes_entered;
+    unsigned long scopes_left;
+    unsigned long max_depth;
+    unsigned long local_lookups;
+    unsigned long local_hits;
+    unsigned long bindings;
+    unsigned long var_lookups;
+    unsigned long chain_steps;
+    unsigned long max_chain;
+};
+
+/**
+ * Collected statistics (shared by all tables and scopes)
+ */
+extern struct symtable_stats symtable_stats;
+
+/**
+ * Executes statement counting statistics
+ */
+#define SYMTABLE_STAT(statement) do { statement; } while (0)
+
+/**
+ * Prints collected statistics.
+ *
+ * @param file Output file.
+ */
+void symtable_stats_print(FILE *file);
+#else
+#define SYMTABLE_STAT(statement) do { } while (0)
+#endif
+
+/**
+ * Block of storage for identifiers.
+ *
+ * Identifiers never move (tokens and other structures point to them),
+ * so table's storage grows by adding new blocks.
+ *
+ * next         previously filled block
+ * used         number of identifiers in the block
+ * capacity     maximal number of identifiers in the block
+ * identifiers  stored identifiers
+ */
+struct symtable_block {
+    struct symtable_block *next;
+    size_t used;
+    size_t capacity;
+    identifier_t identifiers[];
+};
+
+/**
+ * Chunk of table's arena.
+ *
+ * Identifiers and strings of the table are bump-allocated in chunks.
+ * Chunks are kept when the arena is reset and they're reused.
+ *
+ * next      the following chunk
+ * used      number of used bytes
+ * capacity  size of data in bytes
+ * data      allocated space
+ */
+struct symtable_chunk {
+    struct symtable_chunk *next;
+    size_t used;
+    size_t capacity;
+    max_align_t data[];
+};
+
+/**
+ * Slot of symtable.
+ *
+ * Hash and length of the name are stored in the slot, so probing
+ * touches identifiers only when they match.
+ *
+ * identifier  pointer to identifier (NULL in empty slot)
+ * hash        FNV-1a hash of identifier's name
+ * len         length of identifier's name
+ */
+struct symtable_slot {
+    identifier_t *identifier;
+    uint32_t hash;
+    uint32_t len;
+};
 
 /**
  * Structure representing symtable.
  *
- * size     the current number of identifiers in the symtable
- * buckets  the on-creation determined number of buckets
- * items    array of pointers to items, each being the start of corresponding bucket
+ * Open-addressing hash table with linear probing. Table is grown twice
+ * when it's more than 3/4 full.
+ *
+ * size      the current number of identifiers in the symtable
+ * capacity  the current number of slots (power of 2)
+ * slots     array of slots
+ * ctrl      control bytes of slots, the first group is repeated after the last slot (SYMTABLE_SWISS only)
+ * blocks    storage of identifiers (the newest block is the first one, unused with arena)
+ * arena     the first chunk of arena (NULL if the table doesn't have arena)
+ * current   chunk of arena used for allocations
+ * interner  interner of names added without atoms (created by the first symtable_add())
  */
 struct symtable {
     size_t size;
-    size_t buckets;
-    struct symtable_item *items[];
+    size_t capacity;
+    struct symtable_slot *slots;
+#ifdef SYMTABLE_SWISS
+    uint8_t *ctrl;
+#endif
+    struct symtable_block *blocks;
+    struct symtable_chunk *arena;
+    struct symtable_chunk *current;
+    interner_t *interner;
 };
 
 /**
@@ -49,6 +218,26 @@ struct symtable {
  */
 symtable_t *symtable_create(void);
 
+/**
+ * Creates an empty new table with arena.
+ *
+ * Identifiers of the table are allocated in chunks of arena, so clearing
+ * or destroying the table doesn't free them one by one.
+ *
+ * @return  Pointer to newly created table.
+ *          Null on creation failure.
+ */
+symtable_t *symtable_create_arena(void);
+
+/**
+ * Removes all identifiers from table.
+ *
+ * Arena of the table is reset and its chunks are kept for next identifiers.
+ *
+ * @param t Table to clear.
+ */
+void symtable_clear(symtable_t *t);
+
 /**
  * Destroys a table, desposing of all elements in it.
  *
@@ -65,18 +254,48 @@ void symtable_destroy(symtable_t *t);
  * @return  Pointer to identifier with matching name or
  *          Null if matching name is not found.
  */
-identifier_t *symtable_find(symtable_t *t, char *name);
+identifier_t *symtable_find(symtable_t *t, const char *name);
+
+/**
+ * Tries to find an identifier with interned name.
+ *
+ * Names are compared by pointers to their atoms and the atom's hash is used,
+ * so the name isn't read at all.
+ *
+ * @param t Table to find the identifier in.
+ * @param atom Interned name of the identifier to find.
+ *
+ * @return  Pointer to identifier with matching name or
+ *          Null if matching name is not found.
+ */
+identifier_t *symtable_find_atom(symtable_t *t, const atom_t *atom);
 
 /**
  * Adds an identifier to table if it is not already present.
  *
+ * The name is interned by table's own interner, so the identifier is found by its name,
+ * but not by atoms of other interners (use symtable_add_atom() with them).
+ *
  * @param t Table to add the identifier to.
  * @param name Name of the identifier to add.
  *
  * @return  Pointer to the already presest identifier or
  *          pointer to the newly added identifier.
+ *          Null on allocation failure.
+ */
+identifier_t *symtable_add(symtable_t *t, const char *name);
+
+/**
+ * Adds an identifier with interned name to table if it is not already present.
+ *
+ * @param t Table to add the identifier to.
+ * @param atom Interned name of the identifier to add.
+ *
+ * @return  Pointer to the already presest identifier or
+ *          pointer to the newly added identifier.
+ *          Null on allocation failure.
  */
-identifier_t *symtable_add(symtable_t *t, char *name);
+identifier_t *symtable_add_atom(symtable_t *t, const atom_t *atom);
 
 #endif
 
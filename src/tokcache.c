@@ -0,0 +1,558 @@
+/**
+ * @file tokcache.c
+ * Token cache (binary form of scanner's token stream)
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#include "tokcache.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+/**
+ * Initial capacity of the writer's buffer of tokens
+ */
+#define TOKCACHE_INITIAL_CAPACITY 4096
+/**
+ * Initial number of slots of the writer's name index (must be a power of 2)
+ */
+#define TOKCACHE_INITIAL_SLOTS 64
+/**
+ * Length of the header (magic, version, hash and length of the source, checksum of the body)
+ */
+#define TOKCACHE_HEADER_LEN (sizeof(TOKCACHE_MAGIC) - 1 + 1 + 8 + 8 + 8)
+
+// Source: http://isthe.com/chongo/tech/comp/fnv/ (FNV-1a, 64-bit)
+#define OFFSET_BASIS 14695981039346656037u
+#define FNV_PRIME 1099511628211u
+
+/**
+ * Computes hash of the bytes (byte-wise, so every byte affects every bit of the hash)
+ *
+ * @param h Hash of the preceding bytes (OFFSET_BASIS for the first ones)
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @return Hash of the bytes
+ */
+static uint64_t hash_bytes(uint64_t h, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char) data[i];
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+uint64_t tokcache_hash(const source_t *source)
+{
+    assert(source);
+
+    return hash_bytes(OFFSET_BASIS, source->data, source->len);
+}
+
+/**
+ * Makes sure there is space for more bytes in the buffer
+ *
+ * @param buffer Buffer to grow
+ * @param required Number of bytes, which will be appended
+ * @return 0 if success otherwise negative error code
+ */
+static int buffer_reserve(struct tokcache_buffer *buffer, size_t required)
+{
+    size_t capacity = buffer->capacity ? buffer->capacity : TOKCACHE_INITIAL_CAPACITY;
+    unsigned char *data;
+
+    if (buffer->len + required <= buffer->capacity)
+        return 0;
+
+    while (capacity < buffer->len + required)
+        capacity *= 2;
+
+    data = realloc(buffer->data, capacity);
+    if (!data)
+        return -ENOMEM;
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+
+    return 0;
+}
+
+/**
+ * Appends unsigned LEB128 number to the buffer
+ *
+ * @param buffer Buffer to append to
+ * @param value Number to append
+ * @return 0 if success otherwise negative error code
+ */
+static int buffer_put_varint(struct tokcache_buffer *buffer, uint64_t value)
+{
+    if (buffer_reserve(buffer, 10) < 0)
+        return -ENOMEM;
+
+    while (value >= 0x80) {
+        buffer->data[buffer->len++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    buffer->data[buffer->len++] = (unsigned char) value;
+
+    return 0;
+}
+
+/**
+ * Appends little-endian number with fixed size to the buffer
+ *
+ * @param buffer Buffer to append to
+ * @param value Number to append
+ * @param size Number of bytes
+ * @return 0 if success otherwise negative error code
+ */
+static int buffer_put_fixed(struct tokcache_buffer *buffer, uint64_t value, size_t size)
+{
+    if (buffer_reserve(buffer, size) < 0)
+        return -ENOMEM;
+
+    for (size_t i = 0; i < size; i++)
+        buffer->data[buffer->len++] = (unsigned char) (value >> (8 * i));
+
+    return 0;
+}
+
+/**
+ * Appends bytes to the buffer
+ *
+ * @param buffer Buffer to append to
+ * @param bytes Bytes to append
+ * @param n Number of bytes
+ * @return 0 if success otherwise negative error code
+ */
+static int buffer_put_bytes(struct tokcache_buffer *buffer, const void *bytes, size_t n)
+{
+    if (buffer_reserve(buffer, n) < 0)
+        return -ENOMEM;
+
+    if (n > 0)
+        memcpy(buffer->data + buffer->len, bytes, n);
+    buffer->len += n;
+
+    return 0;
+}
+
+tokcache_writer_t *tokcache_writer_create(void)
+{
+    tokcache_writer_t *writer = calloc(1, sizeof(tokcache_writer_t));
+    if (!writer)
+        return NULL;
+
+    writer->name_slots = calloc(TOKCACHE_INITIAL_SLOTS, sizeof(size_t));
+    if (!writer->name_slots) {
+        free(writer);
+        return NULL;
+    }
+    writer->slot_count = TOKCACHE_INITIAL_SLOTS;
+
+    return writer;
+}
+
+/**
+ * Doubles the number of slots of the writer's name index
+ *
+ * @param writer Writer with the index
+ * @return 0 if success otherwise negative error code
+ */
+static int grow_name_index(tokcache_writer_t *writer)
+{
+    size_t slot_count = writer->slot_count * 2;
+    size_t *slots = calloc(slot_count, sizeof(size_t));
+    size_t j;
+
+    if (!slots)
+        return -ENOMEM;
+
+    // Indices are reinserted in the order of names (they're unique, so only empty slot is needed)
+    for (size_t i = 0; i < writer->name_count; i++) {
+        j = writer->names[i]->hash & (slot_count - 1);
+        while (slots[j])
+            j = (j + 1) & (slot_count - 1);
+        slots[j] = i + 1;
+    }
+
+    free(writer->name_slots);
+    writer->name_slots = slots;
+    writer->slot_count = slot_count;
+
+    return 0;
+}
+
+/**
+ * Finds index of the name in the writer's name table (the name is added if it isn't there)
+ *
+ * @param writer Writer with the name table
+ * @param atom Interned name
+ * @return Index of the name or negative error code
+ */
+static long name_index(tokcache_writer_t *writer, const atom_t *atom)
+{
+    size_t mask = writer->slot_count - 1;
+    size_t i = atom->hash & mask;
+    const atom_t **names;
+
+    // Names are interned, so atoms are compared directly
+    while (writer->name_slots[i]) {
+        if (writer->names[writer->name_slots[i] - 1] == atom)
+            return (long) writer->name_slots[i] - 1;
+
+        i = (i + 1) & mask;
+    }
+
+    if (writer->name_count == writer->name_capacity) {
+        writer->name_capacity = writer->name_capacity ? writer->name_capacity * 2 : TOKCACHE_INITIAL_SLOTS;
+        names = realloc(writer->names, writer->name_capacity * sizeof(atom_t *));
+        if (!names)
+            return -ENOMEM;
+        writer->names = names;
+    }
+
+    writer->names[writer->name_count] = atom;
+    writer->name_slots[i] = ++writer->name_count;
+
+    // Keep the index at most half full
+    if (2 * writer->name_count > writer->slot_count && grow_name_index(writer) < 0)
+        return -ENOMEM;
+
+    return (long) writer->name_count - 1;
+}
+
+int tokcache_writer_add(tokcache_writer_t *writer, const tokcache_token_t *token)
+{
+    assert(writer);
+    assert(token);
+
+    struct tokcache_buffer *tokens = &writer->tokens;
+    uint64_t bits;
+    long index;
+    int ret;
+
+    if (writer->finished)
+        return 0;
+
+    ret = buffer_put_fixed(tokens, token->type, 1);
+    if (ret < 0)
+        return ret;
+
+    switch (token->type) {
+        case KEYWORD:
+            return buffer_put_fixed(tokens, token->keyword, 1);
+        case IDENTIFIER:
+            index = name_index(writer, token->identifier.atom);
+            if (index < 0)
+                return (int) index;
+
+            if (buffer_put_varint(tokens, (uint64_t) index) < 0
+                || buffer_put_varint(tokens, token->identifier.line) < 0
+                || buffer_put_varint(tokens, token->identifier.character) < 0)
+                return -ENOMEM;
+
+            return 0;
+        case INTEGER:
+            return buffer_put_fixed(tokens, (uint32_t) token->integer, 4);
+        case NUMBER:
+            memcpy(&bits, &token->number, sizeof(bits));
+            return buffer_put_fixed(tokens, bits, 8);
+        case STRING:
+            if (buffer_put_varint(tokens, token->string.len) < 0)
+                return -ENOMEM;
+
+            return buffer_put_bytes(tokens, token->string.chars, token->string.len);
+        case END:
+            writer->finished = true;
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+int tokcache_writer_save(tokcache_writer_t *writer, FILE *file, const source_t *source)
+{
+    assert(writer);
+    assert(file);
+    assert(source);
+
+    struct tokcache_buffer head = {0, };
+    struct tokcache_buffer body = {0, };
+    int ret = 0;
+
+    if (!writer->finished)
+        return -EINVAL;
+
+    // Name table is known only at the end, tokens are written behind it
+    if (buffer_put_varint(&body, writer->name_count) < 0)
+        ret = -ENOMEM;
+
+    for (size_t i = 0; ret == 0 && i < writer->name_count; i++) {
+        if (buffer_put_varint(&body, writer->names[i]->len) < 0
+            || buffer_put_bytes(&body, writer->names[i]->name, writer->names[i]->len) < 0)
+            ret = -ENOMEM;
+    }
+
+    if (ret == 0 && buffer_put_bytes(&body, writer->tokens.data, writer->tokens.len) < 0)
+        ret = -ENOMEM;
+
+    if (ret == 0
+        && (buffer_put_bytes(&head, TOKCACHE_MAGIC, sizeof(TOKCACHE_MAGIC) - 1) < 0
+            || buffer_put_fixed(&head, TOKCACHE_VERSION, 1) < 0
+            || buffer_put_fixed(&head, tokcache_hash(source), 8) < 0
+            || buffer_put_fixed(&head, source->len, 8) < 0
+            || buffer_put_fixed(&head, hash_bytes(OFFSET_BASIS, (const char *) body.data, body.len), 8) < 0))
+        ret = -ENOMEM;
+
+    if (ret == 0) {
+        if (fwrite(head.data, 1, head.len, file) != head.len
+            || fwrite(body.data, 1, body.len, file) != body.len
+            || fflush(file) != 0)
+            ret = -EIO;
+    }
+
+    free(head.data);
+    free(body.data);
+
+    return ret;
+}
+
+void tokcache_writer_destroy(tokcache_writer_t *writer)
+{
+    assert(writer);
+
+    free(writer->tokens.data);
+    free(writer->names);
+    free(writer->name_slots);
+    free(writer);
+}
+
+/**
+ * Reads unsigned LEB128 number from the cache file
+ *
+ * @param file Loaded cache file
+ * @param value Read number
+ * @return true if success otherwise false (number is incomplete or too long)
+ */
+static bool get_varint(source_t *file, uint64_t *value)
+{
+    unsigned char byte;
+    int shift = 0;
+
+    *value = 0;
+    do {
+        if (file->pos == file->len || shift > 63)
+            return false;
+
+        byte = (unsigned char) file->data[file->pos++];
+        *value |= (uint64_t) (byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return true;
+}
+
+/**
+ * Reads little-endian number with fixed size from the cache file
+ *
+ * @param file Loaded cache file
+ * @param value Read number
+ * @param size Number of bytes
+ * @return true if success otherwise false (there isn't enough data)
+ */
+static bool get_fixed(source_t *file, uint64_t *value, size_t size)
+{
+    if (file->len - file->pos < size)
+        return false;
+
+    *value = 0;
+    for (size_t i = 0; i < size; i++)
+        *value |= (uint64_t) (unsigned char) file->data[file->pos++] << (8 * i);
+
+    return true;
+}
+
+/**
+ * Checks header and body's checksum of the cache file and loads its name table
+ *
+ * @param reader Reader with loaded file
+ * @param source Source the cache should belong to
+ * @param interner Interner for names of identifiers
+ * @return true if the cache is valid and fresh otherwise false
+ */
+static bool load_head(tokcache_reader_t *reader, const source_t *source, interner_t *interner)
+{
+    source_t *file = reader->file;
+    uint64_t checksum;
+    uint64_t value;
+    uint64_t len;
+
+    if (file->len < TOKCACHE_HEADER_LEN
+        || memcmp(file->data, TOKCACHE_MAGIC, sizeof(TOKCACHE_MAGIC) - 1) != 0)
+        return false;
+    file->pos = sizeof(TOKCACHE_MAGIC) - 1;
+
+    // Cache of other version or other (changed) source is unusable
+    if (!get_fixed(file, &value, 1) || value != TOKCACHE_VERSION)
+        return false;
+    if (!get_fixed(file, &value, 8) || value != tokcache_hash(source))
+        return false;
+    if (!get_fixed(file, &value, 8) || value != source->len)
+        return false;
+
+    // Damaged (or truncated) body is detected before anything is read from it
+    if (!get_fixed(file, &checksum, 8)
+        || hash_bytes(OFFSET_BASIS, file->data + file->pos, file->len - file->pos) != checksum)
+        return false;
+
+    // Each name takes at least one byte
+    if (!get_varint(file, &value) || value > file->len - file->pos)
+        return false;
+
+    reader->names = malloc((value ? value : 1) * sizeof(atom_t *));
+    if (!reader->names)
+        return false;
+
+    for (reader->name_count = 0; reader->name_count < value; reader->name_count++) {
+        if (!get_varint(file, &len) || len > file->len - file->pos)
+            return false;
+
+        reader->names[reader->name_count] = interner_intern(interner, file->data + file->pos, len);
+        if (!reader->names[reader->name_count])
+            return false;
+        file->pos += len;
+    }
+
+    return true;
+}
+
+/**
+ * Checks that the tokens can be read and END is at the end of the file
+ *
+ * Tokens are read during parsing, when it's too late to fall back to scanning,
+ * so the whole stream is decoded in advance.
+ *
+ * @param reader Reader with loaded name table
+ * @return true if the stream is valid otherwise false
+ */
+static bool check_tokens(tokcache_reader_t *reader)
+{
+    size_t start = reader->file->pos;
+    tokcache_token_t token;
+
+    do {
+        if (tokcache_reader_next(reader, &token) < 0)
+            return false;
+    } while (token.type != END);
+
+    if (reader->file->pos != reader->file->len)
+        return false;
+
+    reader->file->pos = start;
+    reader->finished = false;
+
+    return true;
+}
+
+tokcache_reader_t *tokcache_reader_open(FILE *file, const source_t *source, interner_t *interner)
+{
+    assert(file);
+    assert(source);
+    assert(interner);
+
+    tokcache_reader_t *reader = calloc(1, sizeof(tokcache_reader_t));
+    if (!reader)
+        return NULL;
+
+    reader->file = source_create(file);
+    if (!reader->file) {
+        free(reader);
+        return NULL;
+    }
+
+    if (!load_head(reader, source, interner) || !check_tokens(reader)) {
+        tokcache_reader_destroy(reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+int tokcache_reader_next(tokcache_reader_t *reader, tokcache_token_t *token)
+{
+    assert(reader);
+    assert(token);
+
+    source_t *file = reader->file;
+    uint64_t value;
+    uint64_t index;
+
+    if (reader->finished) {
+        token->type = END;
+        return 0;
+    }
+
+    if (!get_fixed(file, &value, 1) || value > END)
+        return -EINVAL;
+    token->type = (enum token_type) value;
+
+    switch (token->type) {
+        case KEYWORD:
+            if (!get_fixed(file, &value, 1) || value >= NUMBER_OF_KEYWORDS)
+                return -EINVAL;
+            token->keyword = (keyword_t) value;
+            break;
+        case IDENTIFIER:
+            if (!get_varint(file, &index) || index >= reader->name_count
+                || !get_varint(file, &value) || value > UINT32_MAX)
+                return -EINVAL;
+            token->identifier.atom = reader->names[index];
+            token->identifier.line = (uint32_t) value;
+
+            if (!get_varint(file, &value) || value > UINT32_MAX)
+                return -EINVAL;
+            token->identifier.character = (uint32_t) value;
+            break;
+        case INTEGER:
+            if (!get_fixed(file, &value, 4))
+                return -EINVAL;
+            token->integer = (int) (uint32_t) value;
+            break;
+        case NUMBER:
+            if (!get_fixed(file, &value, 8))
+                return -EINVAL;
+            memcpy(&token->number, &value, sizeof(value));
+            break;
+        case STRING:
+            if (!get_varint(file, &value) || value > file->len - file->pos)
+                return -EINVAL;
+            token->string.chars = file->data + file->pos;
+            token->string.len = value;
+            file->pos += value;
+            break;
+        case END:
+            reader->finished = true;
+            break;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+void tokcache_reader_destroy(tokcache_reader_t *reader)
+{
+    assert(reader);
+
+    source_destroy(reader->file);
+    free(reader->names);
+    free(reader);
+}
@@ -0,0 +1,227 @@
+/**
+ * @file tokcache.h
+ * Header file of token cache (binary form of scanner's token stream)
+ *
+ * Token stream of an unchanged program can be stored into a file and read
+ * back later instead of scanning the program again. The file contains hash
+ * of the program's source, so cache of a changed program is recognized.
+ *
+ * File format (numbers marked as varint are unsigned LEB128, fixed-size
+ * numbers are little-endian):
+ * <ul>
+ *      <li>Header: magic "IFJ21TOK", format version (1 B), hash of the source (8 B),
+ *          length of the source (8 B), hash of the rest of the file (8 B)</li>
+ *      <li>Name table: number of names (varint), then length (varint) and characters of each name</li>
+ *      <li>Tokens: type (1 B) followed by the value of the token type:
+ *          <ul>
+ *              <li>KEYWORD - keyword (1 B)</li>
+ *              <li>IDENTIFIER - index to name table, line and character of the token (3x varint)</li>
+ *              <li>INTEGER - value (4 B)</li>
+ *              <li>NUMBER - bits of the double (8 B)</li>
+ *              <li>STRING - length (varint) and characters of the normalized literal</li>
+ *          </ul>
+ *          The last token is END.</li>
+ * </ul>
+ *
+ * IFJ and IAL project (IFJ21 compiler)
+ * Team: 128 (variant II)
+ *
+ * @author Michal Šmahel (xsmahe01)
+ */
+
+#ifndef _TOKCACHE_H_
+#define _TOKCACHE_H_
+
+#include "token.h"
+#include "kwtable.h"
+#include "interner.h"
+#include "source.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Magic bytes at the start of the cache file
+ */
+#define TOKCACHE_MAGIC "IFJ21TOK"
+/**
+ * Version of the cache file format
+ */
+#define TOKCACHE_VERSION 3
+
+/**
+ * Token in the form stored in cache (identifiers aren't bound to tables of symbols)
+ *
+ * Content:
+ * <ul>
+ *      <li><code>type</code> - Type of the token</li>
+ *      <li><code>keyword</code> - Keyword (KEYWORD)</li>
+ *      <li><code>integer</code> - Value of the literal (INTEGER)</li>
+ *      <li><code>number</code> - Value of the literal (NUMBER)</li>
+ *      <li><code>string</code> - Characters and length of the normalized literal (STRING)</li>
+ *      <li><code>identifier</code> - Interned name and position of the token (IDENTIFIER)</li>
+ * </ul>
+ */
+typedef struct tokcache_token {
+    enum token_type type;
+    union {
+        keyword_t keyword;
+        int integer;
+        double number;
+        struct {
+            const char *chars;
+            size_t len;
+        } string;
+        struct {
+            const atom_t *atom;
+            uint32_t line;
+            uint32_t character;
+        } identifier;
+    };
+} tokcache_token_t;
+
+/**
+ * Growable byte buffer
+ */
+struct tokcache_buffer {
+    unsigned char *data;
+    size_t len;
+    size_t capacity;
+};
+
+/**
+ * Writer of token cache
+ *
+ * Tokens are collected in memory and the file is written at once by tokcache_writer_save().
+ *
+ * Content:
+ * <ul>
+ *      <li><code>tokens</code> - Encoded tokens</li>
+ *      <li><code>names</code> - Name table (atoms in order of the first occurrence)</li>
+ *      <li><code>name_count</code> - Number of names in the table</li>
+ *      <li><code>name_capacity</code> - Capacity of the table</li>
+ *      <li><code>name_slots</code> - Open-addressing index of the table (index + 1, 0 is an empty slot)</li>
+ *      <li><code>slot_count</code> - Number of slots in the index (power of 2)</li>
+ *      <li><code>finished</code> - Has END token been written?</li>
+ * </ul>
+ */
+typedef struct tokcache_writer {
+    struct tokcache_buffer tokens;
+    const atom_t **names;
+    size_t name_count;
+    size_t name_capacity;
+    size_t *name_slots;
+    size_t slot_count;
+    bool finished;
+} tokcache_writer_t;
+
+/**
+ * Reader of token cache
+ *
+ * Content:
+ * <ul>
+ *      <li><code>file</code> - Loaded content of cache file</li>
+ *      <li><code>names</code> - Name table (interned names)</li>
+ *      <li><code>name_count</code> - Number of names in the table</li>
+ *      <li><code>finished</code> - Has END token been read?</li>
+ * </ul>
+ */
+typedef struct tokcache_reader {
+    source_t *file;
+    const atom_t **names;
+    size_t name_count;
+    bool finished;
+} tokcache_reader_t;
+
+/**
+ * Computes hash of the source's content (for detecting stale cache)
+ *
+ * @param source Source to hash (the whole content, cursor is ignored)
+ * @return Hash of the content
+ *
+ * @pre source != NULL
+ */
+uint64_t tokcache_hash(const source_t *source);
+
+/**
+ * Creates a new empty writer
+ *
+ * @return Pointer to the new writer or NULL if error occurred
+ */
+tokcache_writer_t *tokcache_writer_create(void);
+
+/**
+ * Adds token to the cache
+ *
+ * Tokens after END are ignored (END is returned repeatedly by scanner).
+ *
+ * @param writer Writer to add token to
+ * @param token Token to add
+ * @return 0 if success otherwise negative error code
+ *
+ * @pre writer != NULL && token != NULL
+ */
+int tokcache_writer_add(tokcache_writer_t *writer, const tokcache_token_t *token);
+
+/**
+ * Writes the cache file
+ *
+ * @param writer Writer with complete token stream
+ * @param file Opened (binary) output file
+ * @param source Source the tokens were scanned from
+ * @return 0 if success otherwise negative error code (incomplete stream is an error, too)
+ *
+ * @pre writer != NULL && file != NULL && source != NULL
+ */
+int tokcache_writer_save(tokcache_writer_t *writer, FILE *file, const source_t *source);
+
+/**
+ * Destroys writer
+ *
+ * @param writer Writer to destroy
+ *
+ * @pre writer != NULL
+ */
+void tokcache_writer_destroy(tokcache_writer_t *writer);
+
+/**
+ * Opens the cache file for reading tokens
+ *
+ * The whole file is checked here (damaged cache is rejected like a stale one),
+ * so reading tokens from the opened reader doesn't fail.
+ *
+ * @param file Opened (binary) cache file
+ * @param source Source the cache should belong to
+ * @param interner Interner for names of identifiers
+ * @return Pointer to the new reader or NULL if the cache is stale, invalid or error occurred
+ *
+ * @pre file != NULL && source != NULL && interner != NULL
+ */
+tokcache_reader_t *tokcache_reader_open(FILE *file, const source_t *source, interner_t *interner);
+
+/**
+ * Reads the next token from the cache
+ *
+ * END is returned repeatedly at the end of the stream. Strings point to the loaded
+ * file (they're valid until the reader is destroyed) and they aren't null-terminated.
+ *
+ * @param reader Reader to read from
+ * @param token Read token
+ * @return 0 if success otherwise negative error code (the cache is corrupted)
+ *
+ * @pre reader != NULL && token != NULL
+ */
+int tokcache_reader_next(tokcache_reader_t *reader, tokcache_token_t *token);
+
+/**
+ * Destroys reader
+ *
+ * @param reader Reader to destroy
+ *
+ * @pre reader != NULL
+ */
+void tokcache_reader_destroy(tokcache_reader_t *reader);
+
+#endif //_TOKCACHE_H_
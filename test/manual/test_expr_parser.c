@@ -7,12 +7,15 @@ int main(void)
     context_t *context = malloc(sizeof(context_t));
     enum variable_type result;
 
-    context->symstack = symstack_create();
     context->kwtable = kwtable_create();
     context->string = string_create();
+    context->scanner = scanner_create(source_create(stdin));
+    context->literals = NULL;
+    context->interner = interner_create();
+    context->exprstack = exprstack_create();
 
     symtable_t *global_symtable = symtable_create();
-    symstack_push(context->symstack, global_symtable);
+    context->symstack = symstack_create(global_symtable);
 
     result = expr_parser_start(context);
 
@@ -19,7 +19,12 @@ int main() {
 
     printf("\n#-----GEN_FUN_START-----\n");
     id.name = "foo";
-    id.fun.param = "ssin";
+    id.type = FUNCTION;
+    id.fun.param = (signature_t) SIGNATURE(0, 0);
+    signature_append(NULL, &id.fun.param, VAR_STRING);
+    signature_append(NULL, &id.fun.param, VAR_STRING);
+    signature_append(NULL, &id.fun.param, VAR_INTEGER);
+    signature_append(NULL, &id.fun.param, VAR_NUMBER);
     gen_fun_start(&id);
 
     printf("\n#-----GEN_FUN_PARAM-----\n");
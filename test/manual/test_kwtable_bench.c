@@ -0,0 +1,126 @@
+#include "../../src/kwtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Number of passes over all names
+ */
+#define BENCH_ROUNDS 2000000
+
+/**
+ * Identifier-shaped lexemes looked up in the table (keywords mixed with identifiers like in real programs)
+ */
+static const char *names[] = {
+    "local", "a", "integer", "function", "fun_name", "return", "acc", "end", "while", "do", "txt", "string",
+    "if", "then", "else", "number", "nil", "require", "global", "endless", "index", "i", "write", "reads",
+};
+
+/**
+ * Former keyword lookup (array built on the stack and binary search with strcmp())
+ *
+ * @param keyword_name Name of the keyword to search for
+ * @return Index of keyword if found otherwise -1
+ */
+static int old_kwtable_find(const char *keyword_name)
+{
+    // Set of allowed keywords in string form
+    char *keywords[NUMBER_OF_KEYWORDS] = {
+            "do", "else", "end", "function", "global", "if", "integer", "local", "nil",
+            "number", "require", "return", "string", "then", "while"
+    };
+
+    int left = 0, right = NUMBER_OF_KEYWORDS - 1, middle;
+    int compare_result;
+
+    do {
+        middle = (left + right) / 2;
+        compare_result = strcmp(keyword_name, keywords[middle]);
+
+        if (compare_result < 0)
+            right = middle - 1;
+        else if(compare_result > 0)
+            left = middle + 1;
+        else
+            return middle;
+    }
+    while (right >= left);
+
+    return -1;
+}
+
+/**
+ * Prints speed of the measured part
+ *
+ * @param name Name of the measured part
+ * @param lookups Number of done lookups
+ * @param start Clock at the start of measuring
+ */
+static void print_result(const char *name, long lookups, clock_t start)
+{
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-40s %10.2f Mlookups/s (%ld lookups in %.3f s)\n", name, lookups / seconds / 1e6, lookups, seconds);
+}
+
+/**
+ * Number of found keywords (it stops compiler from optimizing lookups out)
+ */
+volatile long found = 0;
+
+int main(void)
+{
+    const int count = sizeof(names) / sizeof(*names);
+    size_t lengths[sizeof(names) / sizeof(*names)];
+    kwtable_t *table = kwtable_create();
+    keyword_t *keyword;
+    clock_t start;
+    long hits;
+
+    if (!table)
+        return 1;
+
+    // Both implementations have to agree
+    for (int i = 0; i < count; i++) {
+        keyword = kwtable_find(table, (char *) names[i]);
+        if ((keyword ? (int) *keyword : -1) != old_kwtable_find(names[i])) {
+            fprintf(stderr, "Implementations differ for \"%s\"\n", names[i]);
+            return 1;
+        }
+
+        // Scanner knows length of the lexeme
+        lengths[i] = strlen(names[i]);
+    }
+
+    hits = 0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < count; i++)
+            hits += old_kwtable_find(names[i]) >= 0;
+    }
+    print_result("binary search with strcmp()", (long) BENCH_ROUNDS * count, start);
+    found += hits;
+
+    hits = 0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < count; i++)
+            hits += kwtable_find(table, (char *) names[i]) != NULL;
+    }
+    print_result("perfect hash (kwtable_find)", (long) BENCH_ROUNDS * count, start);
+    found += hits;
+
+    hits = 0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < count; i++)
+            hits += kwtable_find_n(table, names[i], lengths[i]) != NULL;
+    }
+    print_result("perfect hash (kwtable_find_n)", (long) BENCH_ROUNDS * count, start);
+    found += hits;
+
+    kwtable_destroy(table);
+
+    return 0;
+}
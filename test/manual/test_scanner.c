@@ -21,12 +21,14 @@ char *keywords[] = {
 int main() {
     context_t *context = malloc(sizeof(context_t));
 
-    context->symstack = symstack_create();
     context->kwtable = kwtable_create();
     context->string = string_create();
+    context->scanner = scanner_create(source_create(stdin));
+    context->literals = NULL;
+    context->interner = interner_create();
 
     symtable_t *global_symtable = symtable_create();
-    symstack_push(context->symstack, global_symtable);
+    context->symstack = symstack_create(global_symtable);
 
     token_t token;
     identifier_t *identifier;
@@ -47,7 +49,7 @@ int main() {
                 break;
             case IDENTIFIER:
                 identifier = token.identifier;
-                printf(",\n  .identifier = {\n    .name = %s,\n    .character = %lu,\n    .line = %lu\n  }\n",
+                printf(",\n  .identifier = {\n    .name = %s,\n    .character = %u,\n    .line = %u\n  }\n",
                         identifier->name, identifier->character, identifier->line);
                 break;
             case KEYWORD:
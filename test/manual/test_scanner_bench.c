@@ -0,0 +1,161 @@
+#include "../../src/context.h"
+#include "../../src/token.h"
+#include "../../src/scanner.h"
+#include "../../src/source.h"
+#include "../../src/strpool.h"
+#include "../../src/symstack.h"
+#include "../../src/string_factory.h"
+#include "../../src/symtable.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * Size of generated input program (when no file is given)
+ */
+#define BENCH_INPUT_SIZE (8 * 1024 * 1024)
+
+/**
+ * Piece of IFJ21 code the generated input program is composed from
+ */
+const char *fragment =
+        "--[[ Generated block of the benchmark\n"
+        "     with multi-line comment ]]\n"
+        "function fun_name(a : integer, b : number, s : string) : integer, string\n"
+        "    local acc : integer = a * 42 + 17 // 3 -- line comment\n"
+        "    local num : number = b / 2.5e0 + 0.125 - 1E2\n"
+        "    local txt : string = s .. \"value\\t\\n #\\\\ \\065 end\"\n"
+        "    while acc >= 10 do acc = acc - 1 end\n"
+        "    return acc, txt\n"
+        "end\n";
+
+/**
+ * Writes generated program (or copies the file from path) into temporary file
+ *
+ * @param path Path to input program or NULL for generating one
+ * @return Temporary file with rewound input program
+ */
+static FILE *prepare_input(const char *path)
+{
+    FILE *tmp = tmpfile();
+    FILE *input;
+    size_t written = 0;
+    int c;
+
+    if (!tmp)
+        exit(1);
+
+    if (path) {
+        input = fopen(path, "r");
+        if (!input)
+            exit(1);
+
+        while ((c = getc(input)) != EOF)
+            putc(c, tmp);
+
+        fclose(input);
+    } else {
+        while (written < BENCH_INPUT_SIZE)
+            written += fprintf(tmp, "%s", fragment);
+    }
+
+    rewind(tmp);
+
+    return tmp;
+}
+
+/**
+ * Prints throughput of the measured part
+ *
+ * @param name Name of the measured part
+ * @param bytes Number of processed bytes
+ * @param start Clock at the start of measuring
+ */
+static void print_result(const char *name, long bytes, clock_t start)
+{
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-40s %10.2f MB/s (%ld B in %.3f s)\n", name, bytes / seconds / 1e6, bytes, seconds);
+}
+
+/**
+ * Sum of read characters (it stops compiler from optimizing reading loops out)
+ */
+volatile unsigned long checksum = 0;
+
+int main(int argc, char *argv[])
+{
+    FILE *input = prepare_input(argc > 1 ? argv[1] : NULL);
+    source_t *source;
+    clock_t start;
+    long bytes = 0;
+    int c;
+
+    // Old input layer: stdio call for every character, lookahead pushed back by ungetc()
+    start = clock();
+    while ((c = getc(input)) != EOF) {
+        bytes++;
+        checksum += c;
+        if (!isalnum(c) && !isspace(c)) {
+            ungetc(c, input);
+            getc(input);
+        }
+    }
+    print_result("stdio getc()/ungetc() input", bytes, start);
+
+    // New input layer: the whole input in one buffer with cursor
+    rewind(input);
+    start = clock();
+    source = source_create(input);
+    if (!source)
+        return 1;
+    bytes = 0;
+    while ((c = GET_CHAR(source)) != EOF) {
+        bytes++;
+        checksum += c;
+        if (!isalnum(c) && !isspace(c)) {
+            UNGET_CHAR(source);
+            (void) GET_CHAR(source);
+        }
+    }
+    print_result("buffered source input (incl. loading)", bytes, start);
+
+    // The whole scanner above the buffered source
+    context_t *context = malloc(sizeof(context_t));
+    context->symstack = symstack_create(symtable_create());
+    context->kwtable = kwtable_create();
+    context->string = string_create();
+    context->scanner = scanner_create(source);
+    context->literals = NULL;
+    context->interner = interner_create();
+
+    source->pos = 0;
+    token_t token;
+    start = clock();
+    do {
+        token = get_next_token(context);
+        if (token.type == STRING)
+            free(token.string);
+    } while (token.type != END);
+    print_result("get_next_token() over buffered source", (long) source->len, start);
+
+    // The whole scanner with string literals written into pool
+    context->literals = strpool_create();
+    scanner_destroy(context->scanner);
+    rewind(input);
+    source = source_create(input);
+    context->scanner = scanner_create(source);
+    start = clock();
+    do {
+        token = get_next_token(context);
+    } while (token.type != END);
+    print_result("get_next_token() with literals pool", (long) source->len, start);
+    strpool_destroy(context->literals);
+
+    interner_destroy(context->interner);
+    scanner_destroy(context->scanner);
+    fclose(input);
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include "../../src/symtable.h"
+#include "../../src/interner.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Approximate number of operations of every measured part
+ */
+#define BENCH_OPERATIONS 20000000L
+
+/**
+ * Number of precomputed lookups (indexes of looked up names)
+ */
+#define BENCH_LOOKUPS 65536
+
+/**
+ * Short names typical for local variables and parameters
+ */
+static const char *short_names[] = {
+        "i", "j", "k", "n", "a", "b", "x", "y", "s", "tmp", "acc", "res", "len", "idx", "str", "num",
+};
+
+/**
+ * Parts of longer names (functions, globals...)
+ */
+static const char *name_parts[] = {
+        "read", "write", "count", "value", "result", "input", "index", "sum", "fib", "node", "list", "max",
+};
+
+/**
+ * Generates the name of a symbol
+ *
+ * Names are short at first (like in the scope of a function), longer names
+ * follow and the generated ones (var_N) are used for huge tables.
+ *
+ * @param buffer Buffer for the name
+ * @param size Size of the buffer
+ * @param index Index of the name
+ * @param miss Generate a name, which is never inserted (with the same length distribution)
+ */
+static void generate_name(char *buffer, size_t size, int index, int miss)
+{
+    const int short_count = sizeof(short_names) / sizeof(*short_names);
+    const int part_count = sizeof(name_parts) / sizeof(*name_parts);
+
+    if (index < short_count)
+        snprintf(buffer, size, miss ? "%s_" : "%s", short_names[index]);
+    else if (index < short_count + part_count * part_count)
+        snprintf(buffer, size, miss ? "%s-%s" : "%s_%s", name_parts[(index - short_count) / part_count],
+                 name_parts[(index - short_count) % part_count]);
+    else
+        snprintf(buffer, size, miss ? "var-%d" : "var_%d", index);
+}
+
+/**
+ * Prints speed of the measured part
+ *
+ * @param name Name of the measured part
+ * @param size Number of names in the table
+ * @param operations Number of done operations
+ * @param start Clock at the start of measuring
+ */
+static void print_result(const char *name, int size, long operations, clock_t start)
+{
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-24s %8d names %10.2f Mops/s (%ld operations in %.3f s)\n",
+           name, size, operations / seconds / 1e6, operations, seconds);
+}
+
+/**
+ * Number of found identifiers (it stops compiler from optimizing lookups out)
+ */
+volatile long found = 0;
+
+/**
+ * Measures the table with the given number of names
+ *
+ * @param interner Interner of the names
+ * @param size Number of names
+ * @return 0 if success otherwise 1
+ */
+static int bench_size(interner_t *interner, int size)
+{
+    const atom_t **hits = malloc(size * sizeof(const atom_t *));
+    const atom_t **misses = malloc(size * sizeof(const atom_t *));
+    char **names = malloc(size * sizeof(char *));
+    int *lookups = malloc(BENCH_LOOKUPS * sizeof(int));
+    long rounds = BENCH_OPERATIONS / size + 1;
+    long lookup_rounds = BENCH_OPERATIONS / BENCH_LOOKUPS;
+    symtable_t *table = NULL;
+    char buffer[64];
+    clock_t start;
+    double u;
+    long count;
+
+    if (!hits || !misses || !names || !lookups)
+        return 1;
+
+    for (int i = 0; i < size; i++) {
+        generate_name(buffer, sizeof(buffer), i, 0);
+        hits[i] = interner_intern(interner, buffer, strlen(buffer));
+        names[i] = malloc(strlen(buffer) + 1);
+        if (names[i])
+            strcpy(names[i], buffer);
+        generate_name(buffer, sizeof(buffer), i, 1);
+        misses[i] = interner_intern(interner, buffer, strlen(buffer));
+        if (!hits[i] || !misses[i] || !names[i])
+            return 1;
+    }
+
+    // Lookups are skewed to the first names (loop counters and so are used much more often)
+    srand(42);
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        u = (double) rand() / RAND_MAX;
+        lookups[i] = (int) (u * u * u * (size - 1));
+    }
+
+    start = clock();
+    for (long round = 0; round < rounds; round++) {
+        table = symtable_create();
+        for (int i = 0; i < size; i++)
+            symtable_add_atom(table, hits[i]);
+        if (round != rounds - 1)
+            symtable_destroy(table);
+    }
+    print_result("insert", size, rounds * size, start);
+    symtable_destroy(table);
+
+    // Table with arena is cleared and reused (like a table of short-lived scope)
+    table = symtable_create_arena();
+    start = clock();
+    for (long round = 0; round < rounds; round++) {
+        if (round != 0)
+            symtable_clear(table);
+        for (int i = 0; i < size; i++)
+            symtable_add_atom(table, hits[i]);
+    }
+    print_result("insert (arena, clear)", size, rounds * size, start);
+
+    count = 0;
+    start = clock();
+    for (long round = 0; round < lookup_rounds; round++) {
+        for (int i = 0; i < BENCH_LOOKUPS; i++)
+            count += symtable_find_atom(table, hits[lookups[i]]) != NULL;
+    }
+    print_result("hit (atom)", size, lookup_rounds * BENCH_LOOKUPS, start);
+    if (count != lookup_rounds * BENCH_LOOKUPS) {
+        fprintf(stderr, "Some inserted names weren't found\n");
+        return 1;
+    }
+    found += count;
+
+    count = 0;
+    start = clock();
+    for (long round = 0; round < lookup_rounds; round++) {
+        for (int i = 0; i < BENCH_LOOKUPS; i++)
+            count += symtable_find_atom(table, misses[lookups[i]]) != NULL;
+    }
+    print_result("miss (atom)", size, lookup_rounds * BENCH_LOOKUPS, start);
+    if (count != 0) {
+        fprintf(stderr, "Some names, which weren't inserted, were found\n");
+        return 1;
+    }
+
+    count = 0;
+    start = clock();
+    for (long round = 0; round < lookup_rounds; round++) {
+        for (int i = 0; i < BENCH_LOOKUPS; i++)
+            count += symtable_find(table, names[lookups[i]]) != NULL;
+    }
+    print_result("hit (name)", size, lookup_rounds * BENCH_LOOKUPS, start);
+    found += count;
+
+    symtable_destroy(table);
+    for (int i = 0; i < size; i++)
+        free(names[i]);
+    free(names);
+    free(hits);
+    free(misses);
+    free(lookups);
+
+    return 0;
+}
+
+int main(void)
+{
+    // Scope of a function, program's globals and a huge generated program
+    const int sizes[] = {12, 200, 100000};
+    interner_t *interner = interner_create();
+
+#ifdef SYMTABLE_SWISS
+    printf("Probing: control bytes (groups of %d)\n", SYMTABLE_GROUP_WIDTH);
+#else
+    printf("Probing: linear\n");
+#endif
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+        if (bench_size(interner, sizes[i]) != 0)
+            return 1;
+    }
+
+    interner_destroy(interner);
+
+    return 0;
+}
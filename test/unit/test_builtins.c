@@ -0,0 +1,63 @@
+#include "../../unity/src/unity.h"
+#include "../../src/builtins.h"
+
+#include <string.h>
+
+/**
+ * Finds builtin by its name
+ *
+ * @param name Name of the builtin
+ * @return Index of the builtin or -1
+ */
+static int find(const char *name)
+{
+    return builtins_find(name, strlen(name));
+}
+
+void test_find_all_builtins(void)
+{
+    const char *names[] = {"reads", "readi", "readn", "write", "tointeger", "substr", "ord", "chr"};
+    const char *params[] = {"", "", "", "...", "n", "snn", "si", "i"};
+    const char *retvals[] = {"s", "i", "n", "", "i", "s", "i", "s"};
+    char buffer[SIGNATURE_BUFFER_SIZE];
+    const identifier_t *id;
+    int index;
+
+    TEST_ASSERT_EQUAL_INT(NUMBER_OF_BUILTINS, sizeof(names) / sizeof(*names));
+
+    for (int i = 0; i < NUMBER_OF_BUILTINS; i++) {
+        index = find(names[i]);
+        TEST_ASSERT_TRUE_MESSAGE(index >= 0 && index < NUMBER_OF_BUILTINS, names[i]);
+
+        id = builtins_identifier(index);
+        TEST_ASSERT_EQUAL_STRING(names[i], id->name);
+        TEST_ASSERT_NULL(id->atom);
+        TEST_ASSERT_EQUAL_INT(FUNCTION, id->type);
+        TEST_ASSERT_TRUE(id->defined);
+        TEST_ASSERT_EQUAL_STRING(params[i], signature_format(id->fun.param, buffer));
+        TEST_ASSERT_EQUAL_STRING(retvals[i], signature_format(id->fun.retval, buffer));
+        TEST_ASSERT_EQUAL_INT(i == 3, id->fun.param.varargs);
+    }
+}
+
+void test_find_same_builtin(void)
+{
+    TEST_ASSERT_EQUAL_INT(find("write"), find("write"));
+    TEST_ASSERT_TRUE(find("reads") != find("readi"));
+}
+
+void test_find_not_terminated_name(void)
+{
+    // Names are compared by their length, they needn't be null-terminated
+    TEST_ASSERT_EQUAL_INT(find("write"), builtins_find("writeln", 5));
+    TEST_ASSERT_EQUAL_INT(find("ord"), builtins_find("order", 3));
+    TEST_ASSERT_EQUAL_INT(-1, builtins_find("write", 4));
+}
+
+void test_find_non_builtins(void)
+{
+    const char *names[] = {"", "read", "readx", "writes", "Write", "tointegers", "substr_", "chr2", "ord1", "main", "r"};
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(*names); i++)
+        TEST_ASSERT_EQUAL_INT_MESSAGE(-1, find(names[i]), names[i]);
+}
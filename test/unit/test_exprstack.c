@@ -106,7 +106,7 @@ void test_exprstack_pop_to_stop_valid(void)
 
     // Unfortunately we must look in, because without it, it's hard
     // to check if the top of the stack has been updated successfully
-    result = s->top->term_data;
+    result = s->items[s->count - 1].term_data;
 
     TEST_ASSERT_EQUAL_INT(term.type, result.type);
 }
@@ -468,3 +468,129 @@ void test_exprstack_destroy_non_empty(void)
 
     TEST_PASS();
 }
+
+void test_exprstack_many_items_and_stops(void)
+{
+    exprstack_t *s = exprstack_create();
+    non_term_t non_term = {.type = N_VAL};
+    token_t end = {.type = END};
+    token_t par = {.type = LEFT_PAR};
+
+    // Stack grows over its initial capacity: $ < ( < ( ... < ( N
+    exprstack_push_term(s, end);
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, exprstack_add_stop_after_top_term(s));
+        TEST_ASSERT_EQUAL_INT(0, exprstack_push_term(s, par));
+    }
+    exprstack_push_non_term(s, non_term);
+
+    TEST_ASSERT_EQUAL_INT(LEFT_PAR, exprstack_top_term(s)->type);
+    TEST_ASSERT_TRUE(exprstack_check_top(s, "TN", par));
+
+    // Topmost terminal is updated while popping
+    for (int i = 0; i < 1000; i++) {
+        exprstack_pop_to_stop(s);
+        TEST_ASSERT_EQUAL_INT(i == 999 ? END : LEFT_PAR, exprstack_top_term(s)->type);
+    }
+
+    exprstack_push_non_term(s, non_term);
+    TEST_ASSERT_TRUE(exprstack_is_correctly_empty(s));
+
+    exprstack_destroy(s);
+}
+
+void test_exprstack_stop_below_non_terms(void)
+{
+    exprstack_t *s = exprstack_create();
+    non_term_t non_term = {.type = N_VAL};
+    token_t end = {.type = END};
+    token_t add = {.type = ADDITION};
+
+    // $ < N  -->  $ < < N + N (new stop is right above the terminal, below the non-terminal)
+    exprstack_push_term(s, end);
+    exprstack_add_stop_after_top_term(s);
+    exprstack_push_non_term(s, non_term);
+    exprstack_add_stop_after_top_term(s);
+    exprstack_push_term(s, add);
+    exprstack_push_non_term(s, non_term);
+
+    TEST_ASSERT_TRUE(exprstack_check_top(s, "NTN", add));
+    TEST_ASSERT_FALSE(exprstack_check_top(s, "TN", add));
+
+    exprstack_pop_to_stop(s);
+
+    TEST_ASSERT_EQUAL_INT(END, exprstack_top_term(s)->type);
+    TEST_ASSERT_NULL(exprstack_top_non_term(s));
+
+    exprstack_destroy(s);
+}
+
+void test_exprstack_clear_keeps_space(void)
+{
+    exprstack_t *s = exprstack_create();
+    non_term_t non_term = {.type = N_VAL};
+    token_t end = {.type = END};
+    token_t add = {.type = ADDITION};
+    struct exprstack_item *items;
+
+    exprstack_push_term(s, end);
+    for (int i = 0; i < 100; i++) {
+        exprstack_add_stop_after_top_term(s);
+        exprstack_push_term(s, add);
+    }
+    items = s->items;
+
+    exprstack_clear(s);
+
+    TEST_ASSERT_NULL(exprstack_top_term(s));
+    TEST_ASSERT_NULL(exprstack_top_non_term(s));
+    TEST_ASSERT_FALSE(exprstack_is_correctly_empty(s));
+
+    // The next expression reuses the space of the previous one
+    exprstack_push_term(s, end);
+    exprstack_push_non_term(s, non_term);
+    TEST_ASSERT_TRUE(exprstack_is_correctly_empty(s));
+    TEST_ASSERT_EQUAL_PTR(items, s->items);
+
+    exprstack_destroy(s);
+}
+
+void test_exprstack_handle_shape(void)
+{
+    exprstack_t *s = exprstack_create();
+    non_term_t non_term = {.type = N_VAL};
+    token_t end = {.type = END};
+    token_t add = {.type = ADDITION};
+    token_t left_par = {.type = LEFT_PAR};
+    token_t right_par = {.type = RIGHT_PAR};
+
+    exprstack_push_term(s, end);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_NONE, exprstack_handle_shape(s));
+
+    // $ < (
+    exprstack_add_stop_after_top_term(s);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_NONE, exprstack_handle_shape(s));
+    exprstack_push_term(s, left_par);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_T, exprstack_handle_shape(s));
+
+    // $ < ( N )
+    exprstack_push_non_term(s, non_term);
+    exprstack_push_term(s, right_par);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_TNT, exprstack_handle_shape(s));
+    exprstack_pop_to_stop(s);
+
+    // $ < N + N
+    exprstack_push_non_term(s, non_term);
+    exprstack_add_stop_after_top_term(s);
+    exprstack_push_term(s, add);
+    exprstack_push_non_term(s, non_term);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_NTN, exprstack_handle_shape(s));
+    TEST_ASSERT_TRUE(exprstack_check_top(s, "NTN", add));
+
+    // Handle which is too long has no shape
+    for (int i = 0; i < EXPRSTACK_MAX_HANDLE; i++)
+        exprstack_push_non_term(s, non_term);
+    TEST_ASSERT_EQUAL_UINT(HANDLE_NONE, exprstack_handle_shape(s));
+
+    exprstack_destroy(s);
+}
@@ -0,0 +1,54 @@
+#include "../../unity/src/unity.h"
+#include "../../src/identifier.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void test_identifier_fits_cache_line(void)
+{
+    TEST_ASSERT_TRUE(sizeof(identifier_t) <= 64);
+}
+
+void test_identifier_full_position(void)
+{
+    identifier_t id;
+
+    memset(&id, 0, sizeof(id));
+
+    // Position is part of names of generated variables, so it's never truncated
+    id.line = UINT32_MAX;
+    id.character = 5007;
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, id.line);
+    TEST_ASSERT_EQUAL_UINT32(5007, id.character);
+
+    id.character = UINT32_MAX;
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, id.line);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, id.character);
+}
+
+void test_identifier_clone(void)
+{
+    identifier_t id;
+    identifier_t *clone;
+
+    memset(&id, 0, sizeof(id));
+    id.name = "foo";
+    id.type = FUNCTION;
+    id.defined = true;
+    signature_append(NULL, &id.fun.param, VAR_STRING);
+    signature_append(NULL, &id.fun.retval, VAR_INTEGER);
+    id.line = 3;
+    id.character = 7;
+
+    clone = identifier_clone(&id);
+
+    TEST_ASSERT_TRUE(clone != &id);
+    TEST_ASSERT_EQUAL_STRING("foo", clone->name);
+    TEST_ASSERT_EQUAL_UINT64(3, clone->line);
+    TEST_ASSERT_EQUAL_UINT64(7, clone->character);
+    TEST_ASSERT_TRUE(clone->defined);
+    TEST_ASSERT_TRUE(signature_equal(id.fun.param, clone->fun.param));
+    TEST_ASSERT_TRUE(signature_equal(id.fun.retval, clone->fun.retval));
+
+    free(clone);
+}
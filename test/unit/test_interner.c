@@ -0,0 +1,101 @@
+#include "../../unity/src/unity.h"
+#include "../../src/interner.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void test_interner_hash(void)
+{
+    // Reference values of FNV-1a (32-bit)
+    TEST_ASSERT_EQUAL_HEX32(0x811c9dc5, interner_hash("", 0));
+    TEST_ASSERT_EQUAL_HEX32(0xe40c292c, interner_hash("a", 1));
+    TEST_ASSERT_EQUAL_HEX32(0xbf9cf968, interner_hash("foobar", 6));
+}
+
+void test_interner_intern_same_name(void)
+{
+    interner_t *interner = interner_create();
+    char name[] = "foo_bar";
+    const atom_t *first = interner_intern(interner, "foo_bar", 7);
+    const atom_t *second = interner_intern(interner, name, strlen(name));
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_EQUAL_STRING("foo_bar", first->name);
+    TEST_ASSERT_EQUAL_UINT64(7, first->len);
+    TEST_ASSERT_EQUAL_HEX32(interner_hash("foo_bar", 7), first->hash);
+
+    interner_destroy(interner);
+}
+
+void test_interner_intern_not_terminated_name(void)
+{
+    interner_t *interner = interner_create();
+    const atom_t *prefix = interner_intern(interner, "abcdef", 3);
+    const atom_t *whole = interner_intern(interner, "abcdef", 6);
+
+    TEST_ASSERT_TRUE(prefix != whole);
+    TEST_ASSERT_EQUAL_STRING("abc", prefix->name);
+    TEST_ASSERT_EQUAL_STRING("abcdef", whole->name);
+    TEST_ASSERT_EQUAL_PTR(prefix, interner_intern(interner, "abc", 3));
+
+    interner_destroy(interner);
+}
+
+void test_interner_lookup(void)
+{
+    interner_t *interner = interner_create();
+
+    TEST_ASSERT_NULL(interner_lookup(interner, "x", 1));
+
+    const atom_t *atom = interner_intern(interner, "x", 1);
+
+    TEST_ASSERT_EQUAL_PTR(atom, interner_lookup(interner, "x", 1));
+    TEST_ASSERT_NULL(interner_lookup(interner, "y", 1));
+    TEST_ASSERT_NULL(interner_lookup(interner, "", 0));
+
+    interner_clear(interner);
+    TEST_ASSERT_NULL(interner_lookup(interner, "x", 1));
+
+    interner_destroy(interner);
+}
+
+void test_interner_many_names(void)
+{
+    interner_t *interner = interner_create();
+    const atom_t *atoms[5000];
+    char name[16];
+
+    // Table has to grow several times
+    for (int i = 0; i < 5000; i++) {
+        sprintf(name, "id_%d", i);
+        atoms[i] = interner_intern(interner, name, strlen(name));
+        TEST_ASSERT_NOT_NULL(atoms[i]);
+    }
+
+    for (int i = 0; i < 5000; i++) {
+        sprintf(name, "id_%d", i);
+        TEST_ASSERT_EQUAL_PTR(atoms[i], interner_lookup(interner, name, strlen(name)));
+        TEST_ASSERT_EQUAL_STRING(name, atoms[i]->name);
+    }
+
+    interner_destroy(interner);
+}
+
+void test_interner_independent_interners(void)
+{
+    interner_t *first = interner_create();
+    interner_t *second = interner_create();
+    const atom_t *atom = interner_intern(first, "foo", 3);
+
+    TEST_ASSERT_NOT_NULL(atom);
+    TEST_ASSERT_NULL(interner_lookup(second, "foo", 3));
+    TEST_ASSERT_TRUE(atom != interner_intern(second, "foo", 3));
+    TEST_ASSERT_EQUAL_PTR(atom, interner_lookup(first, "foo", 3));
+
+    // Destroying one of them must not affect the other one
+    interner_destroy(second);
+    TEST_ASSERT_EQUAL_STRING("foo", interner_lookup(first, "foo", 3)->name);
+
+    interner_destroy(first);
+}
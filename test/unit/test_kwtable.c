@@ -1,6 +1,8 @@
 #include "../../unity/src/unity.h"
 #include "../../src/kwtable.h"
 
+#include <string.h>
+
 void test_kwtable_create_success(void) {
     kwtable_create();
 
@@ -60,3 +62,46 @@ void test_kwtable_find_more_keywords(void) {
     TEST_ASSERT_NOT_NULL(keyword_3);
     TEST_ASSERT_EQUAL_INT(KW_ELSE, *keyword_3);
 }
+
+void test_kwtable_find_all_keywords(void) {
+    kwtable_t *table = kwtable_create();
+    const char *names[NUMBER_OF_KEYWORDS] = {
+            "do", "else", "end", "function", "global", "if", "integer", "local", "nil",
+            "number", "require", "return", "string", "then", "while"
+    };
+    keyword_t *keyword;
+
+    // Every keyword has its own slot of perfect hash table
+    for (int i = 0; i < NUMBER_OF_KEYWORDS; i++) {
+        keyword = kwtable_find(table, (char *) names[i]);
+
+        TEST_ASSERT_NOT_NULL_MESSAGE(keyword, names[i]);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i, *keyword, names[i]);
+    }
+
+    kwtable_destroy(table);
+}
+
+void test_kwtable_find_similar_names(void) {
+    kwtable_t *table = kwtable_create();
+    const char *names[] = {"", "d", "dO", "de", "Do", "ends", "endd", "nill", "functiOn", "whale", "retorn", "returns"};
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(*names); i++)
+        TEST_ASSERT_NULL_MESSAGE(kwtable_find(table, (char *) names[i]), names[i]);
+
+    kwtable_destroy(table);
+}
+
+void test_kwtable_find_n_not_terminated_name(void) {
+    kwtable_t *table = kwtable_create();
+    const char *input = "endless";
+
+    keyword_t *keyword_1 = kwtable_find_n(table, input, 3);
+    keyword_t *keyword_2 = kwtable_find_n(table, input, strlen(input));
+
+    TEST_ASSERT_NOT_NULL(keyword_1);
+    TEST_ASSERT_EQUAL_INT(KW_END, *keyword_1);
+    TEST_ASSERT_NULL(keyword_2);
+
+    kwtable_destroy(table);
+}
@@ -1,32 +1,794 @@
 #include "../../unity/src/unity.h"
 #include "../../src/scanner.h"
+#include "../../src/logger.h"
+#include "../../src/exit_codes.h"
 
-void test_unget_token_true_usage(void)
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * States of the original scanner's FSM (before table-driven implementation)
+ */
+enum fsm_states {
+    S_INIT,
+    S_SYMBOL,
+    S_INT, S_DEC, S_NUM, S_EXP, S_EXP_SIGN, S_NUM_EXP,
+    S_DIV, S_INT_DIV,
+    S_PLUS,
+    S_MUL,
+    S_GT, S_GE,
+    S_LT, S_LE,
+    S_ASSIGN, S_EQ,
+    S_TYPE_SPEC,
+    S_COMMA,
+    S_STRLEN,
+    S_LEFT_PAR,
+    S_RIGHT_PAR,
+    S_MINUS, S_DECIDE_COMM, S_LINE_COMM, S_ML_COMM_1, S_ML_COMM_2, S_ML_COMM_3,
+    S_STR_IN, S_STR_OUT, S_ESCAPE, S_ESCAPE_D, S_ESCAPE_DD,
+    S_CAT_1, S_CAT_2,
+    S_NE_1, S_NE_2
+};
+
+/*
+ * Original switch-based scanner kept as a reference for the differential tests
+ */
+static void reference_append_with_normalization(string_t *string, char c)
+{
+    char tmp_char[6]; // Compiler can't see c is at most 3 digits long
+
+    if ((c >= 0 && c <= 32) || c == 35 || c == 92) {
+        // Normalize character into \ddd format (ddd = ASCII position)
+        sprintf(tmp_char, "\\%03d", c);
+
+        for (int i = 0; i < 4; i++) {
+            APPEND_C(string, tmp_char[i]);
+        }
+
+        return;
+    }
+
+    // Just append the char
+    APPEND_C(string, c);
+}
+
+/**
+ * Coordinates of reference scanner (it's the old scanner with global state, so they're reset for each input)
+ */
+static int row = 1; // X coord of input
+static int column = 1; // Y coord of input
+
+static token_t reference_get_next_token(context_t *context)
+{
+    int c; // Loaded char from input source
+    source_t *src = context->scanner->source;
+    enum fsm_states state = S_INIT;
+    keyword_t *tmp_keyword;
+    identifier_t *tmp_identifier;
+    symtable_t *tmp_symtable;
+    token_t token = {0};
+
+    // Prepare string factory
+    string_clear(context->string);
+
+    // Construct token from data in input source
+    c = GET_CHAR(src);
+    while (c != EOF) {
+        // We're using states from enum, default isn't needed
+        switch (state) { // NOLINT(hicpp-multiway-paths-covered)
+            case S_INIT:
+                if (isspace(c)) {
+                    if (c == '\n') {
+                        NEW_ROW(row, column);
+                    }
+
+                    state = S_INIT;
+                }
+                else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+                    APPEND_C(context->string, c);
+                    state = S_SYMBOL;
+                } else if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_INT;
+                } else if (c == '/')
+                    state = S_DIV;
+                else if (c == '+')
+                    state = S_PLUS;
+                else if (c == '*')
+                    state = S_MUL;
+                else if (c == '>')
+                    state = S_GT;
+                else if (c == '<')
+                    state = S_LT;
+                else if (c == '=')
+                    state = S_ASSIGN;
+                else if (c == ':')
+                    state = S_TYPE_SPEC;
+                else if (c == ',')
+                    state = S_COMMA;
+                else if (c == '#')
+                    state = S_STRLEN;
+                else if (c == '(')
+                    state = S_LEFT_PAR;
+                else if (c == ')')
+                    state = S_RIGHT_PAR;
+                else if (c == '-')
+                    state = S_MINUS;
+                else if (c == '"')
+                    state = S_STR_IN;
+                else if (c == '.')
+                    state = S_CAT_1;
+                else if (c == '~')
+                    state = S_NE_1;
+                else
+                    exit(ELEX);
+                break;
+            case S_SYMBOL:
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_SYMBOL;
+                } else {
+                    // We have complete symbol, but we don't know what is it - keyword or identifier?
+                    tmp_keyword = kwtable_find(context->kwtable, string_expose(context->string));
+                    if (tmp_keyword) {
+                        token.type = KEYWORD;
+                        token.keyword = tmp_keyword;
+                    } else {
+                        // Try to find identifier in the table of symbols (tests use only the global scope)
+                        tmp_symtable = symstack_global_symtable(context->symstack);
+                        tmp_identifier = symtable_find(tmp_symtable, string_expose(context->string));
+                        if (!tmp_identifier) {
+                            // Builtin functions are part of the global scope
+                            tmp_identifier = symstack_find_global(context->symstack,
+                                                                  interner_intern(context->interner,
+                                                                                  string_expose(context->string),
+                                                                                  strlen(string_expose(context->string))));
+                        }
+                        if (!tmp_identifier) {
+                            // Create new identifier in the global symtable
+                            tmp_identifier = symtable_add(tmp_symtable, string_expose(context->string));
+
+                            // Setup new identifier
+                            tmp_identifier->line = row;
+                            tmp_identifier->character = column - strlen(string_expose(context->string));
+                        }
+
+                        token.type = IDENTIFIER;
+                        token.identifier = tmp_identifier;
+                    }
+
+                    UNGET_CHAR(src);
+                    return token;
+                }
+                break;
+            case S_INT:
+                APPEND_C(context->string, c);
+
+                if (isdigit(c))
+                    state = S_INT;
+                else if (c == '.')
+                    state = S_DEC;
+                else if (c == 'e' || c == 'E')
+                    state = S_EXP;
+                else {
+                    token.type = INTEGER;
+                    token.integer = (int)strtol(string_expose(context->string), NULL, 10);
+
+                    UNGET_CHAR(src);
+                    return token;
+                }
+                break;
+            case S_DEC:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_NUM;
+                } else
+                    exit(ELEX);
+                break;
+            case S_NUM:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_NUM;
+                } else if (c == 'e' || c == 'E') {
+                    APPEND_C(context->string, c);
+                    state = S_EXP;
+                } else {
+                    token.type = NUMBER;
+                    token.number = strtod(string_expose(context->string), NULL);
+
+                    UNGET_CHAR(src);
+                    return token;
+                }
+                break;
+            case S_EXP:
+                if (c == '+' || c == '-') {
+                    APPEND_C(context->string, c);
+                    state = S_EXP_SIGN;
+                } else if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_NUM_EXP;
+                } else
+                    exit(ELEX);
+                break;
+            case S_EXP_SIGN:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_NUM_EXP;
+                } else
+                    exit(ELEX);
+                break;
+            case S_NUM_EXP:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_NUM_EXP;
+                } else {
+                    token.type = NUMBER;
+                    token.number = strtod(string_expose(context->string), NULL);
+
+                    UNGET_CHAR(src);
+                    return token;
+                }
+                break;
+            case S_DIV:
+                if (c == '/')
+                    state = S_INT_DIV;
+                else {
+                    UNGET_CHAR(src);
+                    return INIT_TOKEN(token, DIVISION);
+                }
+                break;
+            case S_INT_DIV:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, INT_DIVISION);
+            case S_PLUS:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, ADDITION);
+            case S_MUL:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, MULTIPLICATION);
+            case S_GT:
+                if (c == '=')
+                    state = S_GE;
+                else {
+                    UNGET_CHAR(src);
+                    return INIT_TOKEN(token, GT);
+                }
+                break;
+            case S_GE:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, GEQ);
+            case S_LT:
+                if (c == '=')
+                    state = S_LE;
+                else {
+                    UNGET_CHAR(src);
+                    return INIT_TOKEN(token, LT);
+                }
+                break;
+            case S_LE:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, LEQ);
+            case S_ASSIGN:
+                if (c == '=')
+                    state = S_EQ;
+                else {
+                    UNGET_CHAR(src);
+                    return INIT_TOKEN(token, ASSIGNMENT);
+                }
+                break;
+            case S_EQ:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, EQ);
+            case S_TYPE_SPEC:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, TYPE_SPEC);
+            case S_COMMA:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, COMMA);
+            case S_STRLEN:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, STRLEN);
+            case S_LEFT_PAR:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, LEFT_PAR);
+            case S_RIGHT_PAR:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, RIGHT_PAR);
+            case S_MINUS:
+                if (c == '-')
+                    state = S_DECIDE_COMM;
+                else {
+                    UNGET_CHAR(src);
+                    return INIT_TOKEN(token, SUBTRACTION);
+                }
+                break;
+            case S_DECIDE_COMM:
+                if (c == '[')
+                    state = S_ML_COMM_1;
+                else
+                    state = S_LINE_COMM;
+                break;
+            case S_LINE_COMM:
+                if (c == '\n') {
+                    state = S_INIT;
+
+                    NEW_ROW(row, column);
+                }
+                else
+                    state = S_LINE_COMM;
+                break;
+            case S_ML_COMM_1:
+                if (c == '[')
+                    state = S_ML_COMM_2;
+                else
+                    state = S_LINE_COMM;
+                break;
+            case S_ML_COMM_2:
+                if (c == ']')
+                    state = S_ML_COMM_3;
+                else {
+                    if (c == '\n')
+                        NEW_ROW(row, column);
+
+                    state = S_ML_COMM_2;
+                }
+                break;
+            case S_ML_COMM_3:
+                if (c == ']')
+                    state = S_INIT;
+                else
+                    state = S_ML_COMM_2;
+                break;
+            case S_STR_IN:
+                if (c == '"')
+                    state = S_STR_OUT;
+                else if (c == '\n') {
+                    LOG_ERROR_M("Invalid string literal. Missing closing quotes!");
+                    exit(ELEX);
+                }
+                else if (c == '\\')
+                    state = S_ESCAPE;
+                else {
+                    reference_append_with_normalization(context->string, (char) c);
+                    state = S_STR_IN;
+                }
+                break;
+            case S_STR_OUT:
+                token.type = STRING;
+                token.string = string_export(context->string);
+
+                UNGET_CHAR(src);
+                return token;
+            case S_ESCAPE:
+                if (isdigit(c)) {
+                    // Backslash is ignored in other cases, so it needs to be explicitly appended here
+                    APPEND_C(context->string, '\\');
+                    APPEND_C(context->string, c);
+                    state = S_ESCAPE_D;
+                } else if (c == '"' || c == '\\' || c == 'n' || c == 't') {
+                    if (c == 'n')
+                        reference_append_with_normalization(context->string, '\n');
+                    else if (c == 't')
+                        reference_append_with_normalization(context->string, '\t');
+                    else
+                        reference_append_with_normalization(context->string, (char) c);
+
+                    state = S_STR_IN;
+                } else
+                    exit(ELEX);
+                break;
+            case S_ESCAPE_D:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_ESCAPE_DD;
+                } else
+                    exit(ELEX);
+                break;
+            case S_ESCAPE_DD:
+                if (isdigit(c)) {
+                    APPEND_C(context->string, c);
+                    state = S_STR_IN;
+                } else
+                    exit(ELEX);
+                break;
+            case S_CAT_1:
+                if (c == '.')
+                    state = S_CAT_2;
+                else
+                    exit(ELEX);
+                break;
+            case S_CAT_2:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, CONCAT);
+            case S_NE_1:
+                if (c == '=')
+                    state = S_NE_2;
+                else
+                    exit(ELEX);
+                break;
+            case S_NE_2:
+                UNGET_CHAR(src);
+                return INIT_TOKEN(token, NEQ);
+        }
+
+        // Load next character
+        c = GET_CHAR(src);
+        column++;
+    }
+
+    // c == EOF --> we're at the end of input source
+    token.type = END;
+
+    return token;
+}
+
+
+/**
+ * Creates context with dependencies of scanner (source is empty)
+ *
+ * @return Context prepared for scanning
+ */
+static context_t *create_scanner_context(void)
 {
     context_t *context = malloc(sizeof(context_t));
 
-    context->symstack = symstack_create();
+    context->symstack = symstack_create(symtable_create());
     context->kwtable = kwtable_create();
     context->string = string_create();
+    context->scanner = scanner_create(source_from_memory("", 0));
+    context->literals = NULL;
+    context->interner = interner_create();
+
+    return context;
+}
+
+/**
+ * Destroys context with dependencies of scanner
+ *
+ * @param context Context to destroy
+ */
+static void destroy_scanner_context(context_t *context)
+{
+    symtable_t *global = symstack_global_symtable(context->symstack);
+
+    symstack_destroy(context->symstack);
+    symtable_destroy(global);
+    kwtable_destroy(context->kwtable);
+    string_destroy(context->string);
+    scanner_destroy(context->scanner);
+    interner_destroy(context->interner);
+    free(context);
+}
 
+/**
+ * Replaces scanner of the context by a new one with the input
+ *
+ * @param context Context with scanner
+ * @param input Input to scan
+ * @param len Length of the input
+ */
+static void set_scanner_input(context_t *context, const char *input, size_t len)
+{
+    scanner_destroy(context->scanner);
+    context->scanner = scanner_create(source_from_memory(input, len));
+}
+
+void test_unget_token_true_usage(void)
+{
+    context_t *context = create_scanner_context();
     token_t token = {.type = END};
     token_t result;
 
-    unget_token(token);
+    unget_token(context, token);
 
     result = get_next_token(context);
 
     TEST_ASSERT_EQUAL_INT(token.type, result.type);
+
+    destroy_scanner_context(context);
 }
 
 void test_unget_token_bad_usage(void)
 {
-    token_t token1 = {.type = END};
-    token_t token2 = {.type = GT};
+    context_t *context = create_scanner_context();
+    token_t token = {.type = GT};
 
-    unget_token(token1);
-    unget_token(token2);
+    // Lookahead buffer has limited size
+    for (int i = 0; i <= LOOKAHEAD_SIZE; i++)
+        unget_token(context, token);
 
     // It should not fall on error
+    destroy_scanner_context(context);
     TEST_PASS();
 }
+
+/**
+ * Lexemes used for generating random inputs (each of them is a valid input itself)
+ */
+static const char *lexemes[] = {
+    "do", "else", "end", "function", "global", "if", "integer", "local", "nil", "number", "require", "return",
+    "string", "then", "while",
+    "a", "b", "x1", "_tmp", "camelCase", "snake_case_2", "E", "e_x", "n", "t", "endless", "Local", "enumerate",
+    "0", "7", "42", "1234567", "007", "3.14", "0.5", "10.0e2", "2e10", "3E-2", "4.5e+3", "1.0E0",
+    "\"\"", "\"text\"", "\"with spaces and #hash\"", "\"esc \\\" \\\\ \\n \\t\"", "\"num \\065\\010\\255\"",
+    "\"tab\there\"", "\"\\\\\\\\\"", "\"-- not comment\"",
+    "+", "-", "*", "/", "//", "<", "<=", ">", ">=", "=", "==", "~=", ":", ",", "#", "(", ")", "..",
+    "-- line comment\n", "--[ not multi-line\n", "--[[ multi-line ]]", "--[[ multi\nline\n]]",
+    "--[[ ] ]]", "--[[\n-- ]]",
+};
+
+/**
+ * Separators placed between random lexemes
+ */
+static const char *separators[] = {" ", "\n", "\t", "  ", "\r\n", " \v\f "};
+
+/**
+ * Scans the input by both scanners and checks their token streams are the same
+ *
+ * @param input Input to scan
+ * @param len Length of the input
+ * @param pooled Should the tested scanner write string literals into pool?
+ */
+static void assert_same_tokens(const char *input, size_t len, bool pooled)
+{
+    context_t *tested = create_scanner_context();
+    context_t *reference = create_scanner_context();
+    token_t expected;
+    token_t result;
+    char message[64];
+    int index = 0;
+
+    set_scanner_input(tested, input, len);
+    set_scanner_input(reference, input, len);
+    row = 1;
+    column = 1;
+    tested->literals = pooled ? strpool_create() : NULL;
+
+    do {
+        expected = reference_get_next_token(reference);
+        result = get_next_token(tested);
+        sprintf(message, "token %d", index++);
+
+        TEST_ASSERT_EQUAL_INT_MESSAGE(expected.type, result.type, message);
+        switch (expected.type) {
+            case IDENTIFIER:
+                TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.identifier->name, result.identifier->name, message);
+                TEST_ASSERT_EQUAL_UINT64_MESSAGE(expected.identifier->line, result.identifier->line, message);
+                TEST_ASSERT_EQUAL_UINT64_MESSAGE(
+                        expected.identifier->character, result.identifier->character, message
+                );
+                break;
+            case KEYWORD:
+                TEST_ASSERT_EQUAL_INT_MESSAGE(*expected.keyword, *result.keyword, message);
+                break;
+            case INTEGER:
+                TEST_ASSERT_EQUAL_INT_MESSAGE(expected.integer, result.integer, message);
+                break;
+            case NUMBER:
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected.number, &result.number, sizeof(double), message);
+                break;
+            case STRING:
+                TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.string, result.string, message);
+                free(expected.string);
+                if (!pooled)
+                    free(result.string);
+                break;
+            default:
+                break;
+        }
+    } while (expected.type != END);
+
+    if (pooled)
+        strpool_destroy(tested->literals);
+    destroy_scanner_context(tested);
+    destroy_scanner_context(reference);
+}
+
+void test_table_driven_scanner_matches_reference_on_program(void)
+{
+    const char *program =
+            "-- Program 1: Factorial\n"
+            "require \"ifj21\"\n"
+            "function factorial(n : integer) : integer\n"
+            "    local n1 : integer = n - 1\n"
+            "    if n < 2 then return 1 else\n"
+            "        local tmp : integer = factorial(n1)\n"
+            "        return n * tmp\n"
+            "    end\n"
+            "end\n"
+            "--[[ multi-line\n"
+            "     comment ]]\n"
+            "function main()\n"
+            "    local a:number=1.5e-3+#\"abc\"..\"\\t\\\"\\065\"//2~=a>=3<=4==5\n"
+            "    write(a, \"\\n\", 0.25E+2, 12, x_y)\n"
+            "end\n"
+            "main()\n";
+
+    assert_same_tokens(program, strlen(program), false);
+    assert_same_tokens(program, strlen(program), true);
+}
+
+void test_table_driven_scanner_matches_reference_on_edge_cases(void)
+{
+    const char *inputs[] = {
+            "", "\n\n\n", "abc", "12", "1.5", "\"unterminated at EOF", "a --", "a --[[ unterminated",
+            "x--\ny z", "x--[\ny z", "--[[ a ]b ]] c", "--[[ a ]\n] ]] c", "a=1", "a==b~=c", "1 ..2.0",
+            "\"\\\\065\"", "a\tb\vc\fd\re", "\"\x01\x1f\x7f\x80\xff\"",
+            // Runs longer than SIMD blocks (skipped by vectorized code)
+            "a --[[ License block ] which is longer than one SIMD block,\n even two of them\n]] b",
+            "x -- line comment, which is longer than one SIMD block ]] \" # \\ \n y",
+            "\"long string literal with #hash, \\\\backslash and \\\"quotes\\\" in the middle of it\" z",
+            // Numeric literals out of the fast conversion path
+            "99999999999 9223372036854775807 9223372036854775808 000000000000000000000000042",
+            "12345678901234567890123 0.1 1e23 9007199254740993 9007199254740992.0 2.2250738585072014e-308",
+            "1e400 1e-400 0e999999999 0.0000000000000000000000000001 123456789012345678901234567890.5e-10",
+            "4.9e-324 1.7976931348623157e308 5e-324 3.14159265358979323846 7e22 7e23 1e37 100000000000000000e20",
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++) {
+        assert_same_tokens(inputs[i], strlen(inputs[i]), false);
+        assert_same_tokens(inputs[i], strlen(inputs[i]), true);
+    }
+}
+
+void test_table_driven_scanner_matches_reference_on_random_inputs(void)
+{
+    string_t *input = string_create();
+    const char *lexeme;
+    const char *separator;
+
+    srand(128);
+    for (int i = 0; i < 200; i++) {
+        string_clear(input);
+
+        for (int j = 0; j < 100; j++) {
+            lexeme = lexemes[rand() % (sizeof(lexemes) / sizeof(*lexemes))];
+            separator = separators[rand() % (sizeof(separators) / sizeof(*separators))];
+
+            for (size_t k = 0; lexeme[k] != '\0'; k++)
+                string_appendc(input, lexeme[k]);
+            for (size_t k = 0; separator[k] != '\0'; k++)
+                string_appendc(input, separator[k]);
+        }
+
+        assert_same_tokens(string_expose(input), strlen(string_expose(input)), i % 2 == 0);
+    }
+
+    string_destroy(input);
+}
+
+void test_unget_more_tokens(void)
+{
+    context_t *context = create_scanner_context();
+    token_t first = {.type = LT};
+    token_t second = {.type = GT};
+
+    unget_token(context, second);
+    unget_token(context, first);
+
+    TEST_ASSERT_EQUAL_INT(LT, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_INT(GT, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_INT(END, get_next_token(context).type);
+
+    destroy_scanner_context(context);
+}
+
+void test_peek_token(void)
+{
+    context_t *context = create_scanner_context();
+    const char *input = "a = b + 1\n";
+
+    set_scanner_input(context, input, strlen(input));
+
+    // Peeking doesn't consume tokens
+    TEST_ASSERT_EQUAL_INT(ADDITION, peek_token(context, 3).type);
+    TEST_ASSERT_EQUAL_INT(IDENTIFIER, peek_token(context, 0).type);
+    TEST_ASSERT_EQUAL_STRING("a", peek_token(context, 0).identifier->name);
+    TEST_ASSERT_EQUAL_INT(INTEGER, peek_token(context, 4).type);
+    TEST_ASSERT_EQUAL_INT(END, peek_token(context, 5).type);
+    TEST_ASSERT_EQUAL_INT(END, peek_token(context, 6).type);
+
+    TEST_ASSERT_EQUAL_STRING("a", get_next_token(context).identifier->name);
+    TEST_ASSERT_EQUAL_INT(ASSIGNMENT, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_STRING("b", peek_token(context, 0).identifier->name);
+    TEST_ASSERT_EQUAL_STRING("b", get_next_token(context).identifier->name);
+
+    // Ungot token is in front of peeked ones
+    unget_token(context, (token_t) {.type = COMMA});
+    TEST_ASSERT_EQUAL_INT(COMMA, peek_token(context, 0).type);
+    TEST_ASSERT_EQUAL_INT(ADDITION, peek_token(context, 1).type);
+    TEST_ASSERT_EQUAL_INT(COMMA, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_INT(ADDITION, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_INT(1, get_next_token(context).integer);
+    TEST_ASSERT_EQUAL_INT(END, get_next_token(context).type);
+    TEST_ASSERT_EQUAL_INT(END, get_next_token(context).type);
+
+    destroy_scanner_context(context);
+}
+
+void test_independent_scanners(void)
+{
+    context_t *first = create_scanner_context();
+    context_t *second = create_scanner_context();
+    const char *first_input = "\n\nfirst = 1\n";
+    const char *second_input = "second 2 3\n";
+    token_t token;
+
+    set_scanner_input(first, first_input, strlen(first_input));
+    set_scanner_input(second, second_input, strlen(second_input));
+
+    // Interleaved scanning doesn't mix inputs, positions nor lookahead buffers
+    TEST_ASSERT_EQUAL_INT(INTEGER, peek_token(second, 1).type);
+    token = get_next_token(first);
+    TEST_ASSERT_EQUAL_STRING("first", token.identifier->name);
+    TEST_ASSERT_EQUAL_UINT64(3, token.identifier->line);
+    TEST_ASSERT_EQUAL_UINT64(1, token.identifier->character);
+
+    token = get_next_token(second);
+    TEST_ASSERT_EQUAL_STRING("second", token.identifier->name);
+    TEST_ASSERT_EQUAL_UINT64(1, token.identifier->line);
+    TEST_ASSERT_EQUAL_UINT64(1, token.identifier->character);
+
+    unget_token(first, (token_t) {.type = COMMA});
+    TEST_ASSERT_EQUAL_INT(2, get_next_token(second).integer);
+    TEST_ASSERT_EQUAL_INT(COMMA, get_next_token(first).type);
+    TEST_ASSERT_EQUAL_INT(ASSIGNMENT, get_next_token(first).type);
+    TEST_ASSERT_EQUAL_INT(3, get_next_token(second).integer);
+    TEST_ASSERT_EQUAL_INT(1, get_next_token(first).integer);
+    TEST_ASSERT_EQUAL_INT(END, get_next_token(first).type);
+    TEST_ASSERT_EQUAL_INT(END, get_next_token(second).type);
+
+    destroy_scanner_context(first);
+    destroy_scanner_context(second);
+}
+
+void test_number_literals_match_strtod(void)
+{
+    context_t *context = create_scanner_context();
+    string_t *input = string_create();
+    char message[128];
+    token_t token;
+    double expected;
+    int length;
+
+    srand(128);
+    for (int i = 0; i < 20000; i++) {
+        string_clear(input);
+
+        // Random literal: integer part, optional fractional part and optional exponent
+        length = 1 + rand() % 25;
+        for (int j = 0; j < length; j++)
+            string_appendc(input, (char) ('0' + (j == 0 && rand() % 2 ? 0 : rand() % 10)));
+        if (rand() % 2) {
+            string_appendc(input, '.');
+            length = 1 + rand() % 25;
+            for (int j = 0; j < length; j++)
+                string_appendc(input, (char) ('0' + rand() % 10));
+        }
+        if (rand() % 2) {
+            string_appendc(input, rand() % 2 ? 'e' : 'E');
+            if (rand() % 2)
+                string_appendc(input, rand() % 2 ? '+' : '-');
+            length = 1 + rand() % 3;
+            for (int j = 0; j < length; j++)
+                string_appendc(input, (char) ('0' + rand() % 10));
+        }
+        string_appendc(input, ' ');
+
+        snprintf(message, sizeof(message), "literal %s", string_expose(input));
+        set_scanner_input(context, string_expose(input), strlen(string_expose(input)));
+        token = get_next_token(context);
+
+        if (token.type == INTEGER) {
+            TEST_ASSERT_EQUAL_INT_MESSAGE((int) strtol(string_expose(input), NULL, 10), token.integer, message);
+        } else {
+            TEST_ASSERT_EQUAL_INT_MESSAGE(NUMBER, token.type, message);
+            expected = strtod(string_expose(input), NULL);
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected, &token.number, sizeof(double), message);
+        }
+    }
+
+    string_destroy(input);
+    destroy_scanner_context(context);
+}
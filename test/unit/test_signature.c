@@ -0,0 +1,208 @@
+#include "../../unity/src/unity.h"
+#include "../../src/signature.h"
+
+#include <string.h>
+
+/**
+ * Pool for types of long signatures (each test has its own one)
+ */
+static signature_pool_t *pool;
+
+void setUp(void)
+{
+    pool = signature_pool_create();
+}
+
+void tearDown(void)
+{
+    signature_pool_destroy(pool);
+}
+
+/**
+ * Makes signature from textual form
+ *
+ * @param types Types like "snn"
+ * @return Signature with the types
+ */
+static signature_t make(const char *types)
+{
+    signature_t signature = SIGNATURE(0, 0);
+
+    for (size_t i = 0; i < strlen(types); i++)
+        TEST_ASSERT_EQUAL_INT(0, signature_append(pool, &signature, (enum variable_type) types[i]));
+
+    return signature;
+}
+
+void test_signature_append_and_type(void)
+{
+    signature_t signature = make("snib");
+    char buffer[SIGNATURE_BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(4, signature.len);
+    TEST_ASSERT_EQUAL_INT(VAR_STRING, signature_type(signature, 0));
+    TEST_ASSERT_EQUAL_INT(VAR_NUMBER, signature_type(signature, 1));
+    TEST_ASSERT_EQUAL_INT(VAR_INTEGER, signature_type(signature, 2));
+    TEST_ASSERT_EQUAL_INT(VAR_BOOL, signature_type(signature, 3));
+    TEST_ASSERT_EQUAL_INT(0, signature_type(signature, 4));
+    TEST_ASSERT_EQUAL_STRING("snib", signature_format(signature, buffer));
+
+    signature_clear(&signature);
+    TEST_ASSERT_EQUAL_INT(0, signature.len);
+    TEST_ASSERT_EQUAL_STRING("", signature_format(signature, buffer));
+}
+
+/**
+ * Makes textual form of a long signature
+ *
+ * @param buffer Buffer for the types
+ * @param len Number of types
+ * @param pattern Types repeated in the signature
+ * @return The buffer
+ */
+static char *make_types(char *buffer, size_t len, const char *pattern)
+{
+    for (size_t i = 0; i < len; i++)
+        buffer[i] = pattern[i % strlen(pattern)];
+    buffer[len] = '\0';
+
+    return buffer;
+}
+
+void test_signature_without_pool(void)
+{
+    signature_t signature = SIGNATURE(0, 0);
+
+    // Short signatures don't need the pool
+    for (int i = 0; i < SIGNATURE_PACKED_TYPES; i++)
+        TEST_ASSERT_EQUAL_INT(0, signature_append(NULL, &signature, i % 2 ? VAR_NUMBER : VAR_BOOL));
+
+    TEST_ASSERT_TRUE(signature_append(NULL, &signature, VAR_STRING) < 0);
+    TEST_ASSERT_EQUAL_INT(SIGNATURE_PACKED_TYPES, signature.len);
+    TEST_ASSERT_EQUAL_INT(VAR_NUMBER, signature_type(signature, SIGNATURE_PACKED_TYPES - 1));
+}
+
+void test_signature_long(void)
+{
+    char types[301];
+    char expected[SIGNATURE_BUFFER_SIZE];
+    char buffer[SIGNATURE_BUFFER_SIZE];
+    signature_t signature = make(make_types(types, 300, "snibn"));
+
+    TEST_ASSERT_EQUAL_INT(300, signature.len);
+    for (int i = 0; i < 300; i++)
+        TEST_ASSERT_EQUAL_INT(types[i], signature_type(signature, i));
+    TEST_ASSERT_EQUAL_INT(0, signature_type(signature, 300));
+
+    // Textual form is shortened
+    make_types(expected, SIGNATURE_FORMAT_TYPES, "snibn");
+    strcat(expected, "...");
+    TEST_ASSERT_EQUAL_STRING(expected, signature_format(signature, buffer));
+
+    TEST_ASSERT_TRUE(signature_equal(signature, make(types)));
+    types[200] = 'i';
+    TEST_ASSERT_FALSE(signature_equal(signature, make(types)));
+    types[299] = '\0';
+    TEST_ASSERT_FALSE(signature_equal(signature, make(types)));
+}
+
+void test_signature_long_copies(void)
+{
+    char types[101];
+    signature_t original = make(make_types(types, 40, "ns"));
+    signature_t first = original;
+    signature_t second = original;
+
+    // Copies share types of the original, but appending to one of them doesn't change the others
+    TEST_ASSERT_EQUAL_INT(0, signature_append(pool, &first, VAR_INTEGER));
+    TEST_ASSERT_EQUAL_INT(0, signature_append(pool, &second, VAR_STRING));
+    for (int i = 0; i < 60; i++)
+        TEST_ASSERT_EQUAL_INT(0, signature_append(pool, &first, VAR_BOOL));
+
+    TEST_ASSERT_EQUAL_INT(40, original.len);
+    TEST_ASSERT_EQUAL_INT(0, signature_type(original, 40));
+    TEST_ASSERT_EQUAL_INT(VAR_INTEGER, signature_type(first, 40));
+    TEST_ASSERT_EQUAL_INT(VAR_BOOL, signature_type(first, 100));
+    TEST_ASSERT_EQUAL_INT(VAR_STRING, signature_type(second, 40));
+    TEST_ASSERT_TRUE(signature_equal(original, make(types)));
+    TEST_ASSERT_TRUE(signature_is_prefix(original, first));
+    TEST_ASSERT_TRUE(signature_is_prefix(original, second));
+    TEST_ASSERT_FALSE(signature_is_prefix(first, second));
+
+    signature_clear(&first);
+    TEST_ASSERT_EQUAL_INT(0, first.len);
+    TEST_ASSERT_EQUAL_INT(VAR_STRING, signature_type(second, 40));
+}
+
+void test_signature_equal(void)
+{
+    signature_t varargs = SIGNATURE_VARARGS;
+
+    TEST_ASSERT_TRUE(signature_equal(make(""), make("")));
+    TEST_ASSERT_TRUE(signature_equal(make("sin"), make("sin")));
+    TEST_ASSERT_FALSE(signature_equal(make("sin"), make("sis")));
+    TEST_ASSERT_FALSE(signature_equal(make("sin"), make("si")));
+    // Integer has zero code, so the length has to be compared too
+    TEST_ASSERT_FALSE(signature_equal(make("s"), make("si")));
+    TEST_ASSERT_FALSE(signature_equal(make(""), varargs));
+}
+
+void test_signature_is_prefix(void)
+{
+    TEST_ASSERT_TRUE(signature_is_prefix(make(""), make("")));
+    TEST_ASSERT_TRUE(signature_is_prefix(make(""), make("sn")));
+    TEST_ASSERT_TRUE(signature_is_prefix(make("s"), make("sn")));
+    TEST_ASSERT_TRUE(signature_is_prefix(make("sn"), make("sn")));
+    TEST_ASSERT_FALSE(signature_is_prefix(make("sni"), make("sn")));
+    TEST_ASSERT_FALSE(signature_is_prefix(make("n"), make("sn")));
+    TEST_ASSERT_FALSE(signature_is_prefix(make("i"), make("")));
+    // Prefix check doesn't allow implicit conversions
+    TEST_ASSERT_FALSE(signature_is_prefix(make("n"), make("i")));
+}
+
+void test_signature_assignable(void)
+{
+    TEST_ASSERT_TRUE(signature_assignable(make("sib"), make("sib")));
+
+    // Redundant values are dropped
+    TEST_ASSERT_TRUE(signature_assignable(make("s"), make("sib")));
+    TEST_ASSERT_TRUE(signature_assignable(make(""), make("n")));
+    TEST_ASSERT_FALSE(signature_assignable(make("si"), make("s")));
+
+    // Integers are converted to numbers, but not the other way
+    TEST_ASSERT_TRUE(signature_assignable(make("nsnn"), make("isni")));
+    TEST_ASSERT_TRUE(signature_converts(make("nsnn"), make("isni"), 0));
+    TEST_ASSERT_FALSE(signature_converts(make("nsnn"), make("isni"), 1));
+    TEST_ASSERT_FALSE(signature_converts(make("nsnn"), make("isni"), 2));
+    TEST_ASSERT_TRUE(signature_converts(make("nsnn"), make("isni"), 3));
+    TEST_ASSERT_FALSE(signature_assignable(make("i"), make("n")));
+    TEST_ASSERT_FALSE(signature_assignable(make("n"), make("s")));
+    TEST_ASSERT_FALSE(signature_assignable(make("s"), make("b")));
+    TEST_ASSERT_FALSE(signature_assignable(make("b"), make("i")));
+}
+
+void test_signature_assignable_long(void)
+{
+    char target[101];
+    char source[102];
+
+    make_types(target, 100, "n");
+    make_types(source, 101, "i");
+
+    TEST_ASSERT_TRUE(signature_assignable(make(target), make(source)));
+    TEST_ASSERT_TRUE(signature_converts(make(target), make(source), 99));
+    TEST_ASSERT_FALSE(signature_assignable(make(source), make(target)));
+
+    source[70] = 's';
+    TEST_ASSERT_FALSE(signature_assignable(make(target), make(source)));
+    TEST_ASSERT_TRUE(signature_is_prefix(make("iii"), make(source)));
+}
+
+void test_signature_format_varargs(void)
+{
+    signature_t varargs = SIGNATURE_VARARGS;
+    char buffer[SIGNATURE_BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL_STRING("...", signature_format(varargs, buffer));
+    TEST_ASSERT_EQUAL_INT(0, signature_type(varargs, 0));
+}
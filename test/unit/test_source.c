@@ -0,0 +1,118 @@
+#include "../../unity/src/unity.h"
+#include "../../src/source.h"
+
+#include <string.h>
+
+/**
+ * Implementations of skipping to test
+ */
+static const enum source_skip_impl impls[] = {SKIP_IMPL_SCALAR, SKIP_IMPL_SSE2, SKIP_IMPL_AVX2};
+
+/**
+ * Tests skipping by all implementations supported on this CPU
+ *
+ * @param data Source content
+ * @param target Set of characters to stop at
+ * @param expected Expected number of skipped characters
+ */
+static void assert_skip(const char *data, enum source_skip_target target, size_t expected)
+{
+    source_t *src;
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(*impls); i++) {
+        src = source_from_memory(data, strlen(data));
+        if (!source_use_skip_impl(src, impls[i])) {
+            source_destroy(src);
+            continue;
+        }
+
+        TEST_ASSERT_EQUAL_UINT64(expected, source_skip(src, target));
+        TEST_ASSERT_EQUAL_UINT64(expected, src->pos);
+
+        source_destroy(src);
+    }
+}
+
+void test_source_skip_to_eol(void)
+{
+    assert_skip("comment ] \" # \\ \t text\nnext line", SKIP_TO_EOL, 22);
+}
+
+void test_source_skip_to_eol_or_rbracket(void)
+{
+    assert_skip("multi-line comment with \" and # \t]] after", SKIP_TO_EOL_OR_RBRACKET, 33);
+    assert_skip("multi-line comment with \" and # \t\n]] after", SKIP_TO_EOL_OR_RBRACKET, 33);
+}
+
+void test_source_skip_to_string_special(void)
+{
+    assert_skip("plain_string_with_\x7f\x80\xff_chars\"", SKIP_TO_STRING_SPECIAL, 27);
+    assert_skip("plain_string_with_space after", SKIP_TO_STRING_SPECIAL, 23);
+    assert_skip("plain_string_with_tab\tafter", SKIP_TO_STRING_SPECIAL, 21);
+    assert_skip("plain_string_with_#_after", SKIP_TO_STRING_SPECIAL, 18);
+    assert_skip("plain_string_with_\\_after", SKIP_TO_STRING_SPECIAL, 18);
+    assert_skip("plain_string_with_\x01_after", SKIP_TO_STRING_SPECIAL, 18);
+}
+
+void test_source_skip_to_the_end(void)
+{
+    assert_skip("", SKIP_TO_EOL, 0);
+    assert_skip("no EOL in the whole source (longer than 32 bytes)", SKIP_TO_EOL, 49);
+    assert_skip("no_special_characters_in_the_whole_source", SKIP_TO_STRING_SPECIAL, 41);
+}
+
+void test_source_skip_stops_at_every_position(void)
+{
+    char data[101];
+    source_t *src;
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(*impls); i++) {
+        for (size_t stop = 0; stop < 100; stop++) {
+            memset(data, 'a', 100);
+            data[100] = '\0';
+            data[stop] = '"';
+            // Stop character in the following block mustn't be found instead
+            if (stop + 1 < 100)
+                data[stop + 1] = '#';
+
+            src = source_from_memory(data, 100);
+            if (!source_use_skip_impl(src, impls[i])) {
+                source_destroy(src);
+                break;
+            }
+            src->pos = stop / 3;
+
+            TEST_ASSERT_EQUAL_UINT64(stop - stop / 3, source_skip(src, SKIP_TO_STRING_SPECIAL));
+            TEST_ASSERT_EQUAL_UINT64(stop, src->pos);
+
+            source_destroy(src);
+        }
+    }
+}
+
+void test_source_skip_at_the_end(void)
+{
+    source_t *src = source_from_memory("abc", 3);
+    src->pos = 3;
+
+    TEST_ASSERT_EQUAL_UINT64(0, source_skip(src, SKIP_TO_EOL));
+    TEST_ASSERT_EQUAL_UINT64(3, src->pos);
+
+    source_destroy(src);
+}
+
+void test_source_skip_impl_is_per_source(void)
+{
+    source_t *first = source_from_memory("abc\n", 4);
+    source_t *second = source_from_memory("abc\n", 4);
+    source_skip_fn selected = second->skip;
+
+    // Forcing implementation of one source doesn't change the others
+    TEST_ASSERT_NOT_NULL(first->skip);
+    TEST_ASSERT_TRUE(source_use_skip_impl(first, SKIP_IMPL_SCALAR));
+    TEST_ASSERT_EQUAL_PTR(selected, second->skip);
+    TEST_ASSERT_EQUAL_UINT64(3, source_skip(second, SKIP_TO_EOL));
+
+    source_destroy(first);
+    source_destroy(second);
+}
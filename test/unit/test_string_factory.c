@@ -64,6 +64,33 @@ void test_append_multiple_character_to_string()
     TEST_ASSERT_EQUAL_INT(2*INIT_MAX, string->max_len);
 }
 
+void test_append_run_of_characters_to_string()
+{
+    int ret;
+    string_t *string = string_create();
+    append_to_string(string, "ab");
+
+    ret = string_appendn(string, "cdefghijklmnopqrstuvwxyz", 5);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(7, string->len);
+    TEST_ASSERT_EQUAL_STRING("abcdefg", string->content);
+}
+
+void test_append_long_run_of_characters_to_string()
+{
+    char *chars = "0123456789012345678901234567890123456789012345678";
+    int ret;
+    string_t *string = string_create();
+
+    ret = string_appendn(string, chars, strlen(chars));
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(strlen(chars), string->len);
+    TEST_ASSERT_EQUAL_INT(4*INIT_MAX, string->max_len);
+    TEST_ASSERT_EQUAL_STRING(chars, string->content);
+}
+
 void test_string_cmp_empty_str1_empty_str2()
 {
     int ret;
@@ -0,0 +1,100 @@
+#include "../../unity/src/unity.h"
+#include "../../src/strpool.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void test_strpool_create(void)
+{
+    strpool_t *pool = strpool_create();
+
+    TEST_ASSERT_NOT_NULL(pool);
+    TEST_ASSERT_NULL(pool->chunks);
+
+    strpool_destroy(pool);
+}
+
+void test_strpool_finish_string(void)
+{
+    strpool_t *pool = strpool_create();
+    char *string;
+
+    TEST_ASSERT_EQUAL_INT(0, strpool_appendn(pool, "hello", 5));
+    TEST_ASSERT_EQUAL_INT(0, strpool_appendn(pool, " world!!!", 6));
+    string = strpool_finish(pool);
+
+    TEST_ASSERT_EQUAL_STRING("hello world", string);
+
+    strpool_destroy(pool);
+}
+
+void test_strpool_finish_empty_string(void)
+{
+    strpool_t *pool = strpool_create();
+    char *first = strpool_finish(pool);
+    char *second = strpool_finish(pool);
+
+    TEST_ASSERT_EQUAL_STRING("", first);
+    TEST_ASSERT_EQUAL_STRING("", second);
+    TEST_ASSERT_TRUE(first != second);
+
+    strpool_destroy(pool);
+}
+
+void test_strpool_strings_stay_valid(void)
+{
+    strpool_t *pool = strpool_create();
+    char *strings[1000];
+    char expected[16];
+
+    // Strings don't fit into one chunk
+    for (int i = 0; i < 1000; i++) {
+        sprintf(expected, "string %d", i);
+        for (int j = 0; j < 100; j++)
+            strpool_appendn(pool, expected, strlen(expected));
+        strings[i] = strpool_finish(pool);
+    }
+
+    TEST_ASSERT_NOT_NULL(pool->chunks->next);
+    for (int i = 0; i < 1000; i++) {
+        sprintf(expected, "string %d", i);
+        TEST_ASSERT_EQUAL_UINT64(100 * strlen(expected), strlen(strings[i]));
+        TEST_ASSERT_EQUAL_MEMORY(expected, strings[i] + 99 * strlen(expected), strlen(expected));
+    }
+
+    strpool_destroy(pool);
+}
+
+void test_strpool_string_longer_than_chunk(void)
+{
+    strpool_t *pool = strpool_create();
+    static char long_string[3 * STRPOOL_CHUNK_SIZE];
+    char *string;
+
+    memset(long_string, 'x', sizeof(long_string) - 1);
+    strpool_appendn(pool, "prefix ", 7);
+    strpool_finish(pool);
+    strpool_appendn(pool, "start ", 6);
+    strpool_appendn(pool, long_string, sizeof(long_string) - 1);
+    string = strpool_finish(pool);
+
+    TEST_ASSERT_EQUAL_MEMORY("start x", string, 7);
+    TEST_ASSERT_EQUAL_UINT64(6 + sizeof(long_string) - 1, strlen(string));
+
+    strpool_destroy(pool);
+}
+
+void test_strpool_discard(void)
+{
+    strpool_t *pool = strpool_create();
+    char *string;
+
+    strpool_appendn(pool, "unfinished", 10);
+    strpool_discard(pool);
+    strpool_appendn(pool, "finished", 8);
+    string = strpool_finish(pool);
+
+    TEST_ASSERT_EQUAL_STRING("finished", string);
+
+    strpool_destroy(pool);
+}
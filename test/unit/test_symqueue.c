@@ -138,3 +138,32 @@ void test_symqueue_peek(void)
     TEST_ASSERT_NOT_NULL(res);
     TEST_ASSERT_EQUAL_PTR(item1, res);
 }
+
+void test_symqueue_wrap_around_and_grow(void)
+{
+    symqueue_t *symqueue = symqueue_create();
+    identifier_t items[100];
+    int next_pop = 0;
+    int next_add = 0;
+
+    // Items wrap around the end of the array, then the array grows with wrapped items
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 5 + round; i++) {
+            TEST_ASSERT_TRUE(symqueue_add(symqueue, &items[next_add++]));
+            TEST_ASSERT_EQUAL_PTR(&items[next_add - 1], symqueue_rear(symqueue));
+        }
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT_EQUAL_PTR(&items[next_pop], symqueue_peek(symqueue));
+            TEST_ASSERT_EQUAL_PTR(&items[next_pop++], symqueue_pop(symqueue));
+        }
+    }
+
+    while (next_pop < next_add)
+        TEST_ASSERT_EQUAL_PTR(&items[next_pop++], symqueue_pop(symqueue));
+
+    TEST_ASSERT_TRUE(symqueue_is_empty(symqueue));
+    TEST_ASSERT_NULL(symqueue_pop(symqueue));
+    TEST_ASSERT_NULL(symqueue_rear(symqueue));
+
+    symqueue_destroy(symqueue);
+}
@@ -2,294 +2,287 @@
 #include "../../src/symstack.h"
 #include "../../src/symtable.h"
 
-void test_symstack_init(void)
-{
-    symstack_t *symstack = symstack_create();
-
-    TEST_ASSERT_NOT_NULL(symstack);
-}
-
-void test_symstack_push_one(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t = symtable_create();
-
-    symstack_push(symstack, t);
-
-    symstack_most_local(symstack);
-    result = symstack_get(symstack);
-
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t, result);
-}
-
-void test_symstack_push_more(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
-    symtable_t *t3 = symtable_create();
-
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_push(symstack, t3);
-
-    symstack_most_local(symstack);
-    result = symstack_get(symstack);
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t3, result);
-}
-
-void test_symstack_pop_empty(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
+#include <stdio.h>
 
-    result = symstack_pop(symstack);
+/**
+ * Interner of names used by the tests (each test has its own one)
+ */
+static interner_t *interner;
 
-    TEST_ASSERT_NULL(result);
-}
-
-void test_symstack_pop_one_item_symstack(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t = symtable_create();
-
-    symstack_push(symstack, t);
-    result = symstack_pop(symstack);
-
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t, result);
-}
-
-void test_symstack_pop_more_items_symstack(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
-    symtable_t *t3 = symtable_create();
-
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_push(symstack, t3);
-
-    result = symstack_pop(symstack);
-
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t3, result);
-}
-
-void test_symstack_pop_more_items_from_more_items_symstack(void)
+void setUp(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
-    symtable_t *t3 = symtable_create();
-
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_push(symstack, t3);
-
-    symstack_pop(symstack);
-    result = symstack_pop(symstack);
-
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t2, result);
+    interner = interner_create();
 }
 
-void test_symstack_top_empty(void)
+void tearDown(void)
 {
-    symstack_t *symstack = symstack_create();
-
-    symstack_most_local(symstack);
-
-    TEST_PASS();
+    interner_destroy(interner);
 }
 
-void test_symstack_get_empty(void)
+void test_symstack_init(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
 
-    result = symstack_get(symstack);
+    TEST_ASSERT_NOT_NULL(symstack);
+    TEST_ASSERT_EQUAL_PTR(global, symstack_global_symtable(symstack));
+    TEST_ASSERT_EQUAL_UINT64(0, symstack_depth(symstack));
 
-    TEST_ASSERT_NULL(result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_next_empty(void)
+void test_symstack_push_and_pop_scopes(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-
-    symstack_most_local(symstack);
-
-    symstack_next(symstack);
-    result = symstack_get(symstack);
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
 
-    TEST_ASSERT_NULL(result);
-}
-
-void test_symstack_next_classic(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
+    TEST_ASSERT_EQUAL_INT(0, symstack_push_scope(symstack));
+    TEST_ASSERT_EQUAL_INT(0, symstack_push_scope(symstack));
+    TEST_ASSERT_EQUAL_UINT64(2, symstack_depth(symstack));
 
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_most_local(symstack);
+    TEST_ASSERT_EQUAL_INT(0, symstack_pop_scope(symstack));
+    TEST_ASSERT_EQUAL_UINT64(1, symstack_depth(symstack));
+    TEST_ASSERT_EQUAL_INT(0, symstack_pop_scope(symstack));
+    TEST_ASSERT_EQUAL_UINT64(0, symstack_depth(symstack));
 
-    symstack_next(symstack);
-    result = symstack_get(symstack);
+    // Global scope can't be left
+    TEST_ASSERT_TRUE(symstack_pop_scope(symstack) < 0);
+    TEST_ASSERT_EQUAL_PTR(global, symstack_global_symtable(symstack));
 
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t1, result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_next_overflow(void)
+void test_symstack_global_scope_uses_global_symtable(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "foo", 3);
+    identifier_t *id;
 
-    symstack_push(symstack, t1);
-    symstack_most_local(symstack);
+    id = symstack_add_local(symstack, atom);
 
-    symstack_next(symstack);
-    result = symstack_get(symstack);
+    TEST_ASSERT_NOT_NULL(id);
+    TEST_ASSERT_EQUAL_PTR(id, symtable_find_atom(global, atom));
+    TEST_ASSERT_EQUAL_PTR(id, symstack_find_local(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(id, symstack_add_local(symstack, atom));
 
-    TEST_ASSERT_NULL(result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_global_symtable_empty(void)
+void test_symstack_block_scope(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-
-    result = symstack_global_symtable(symstack);
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "foo", 3);
+    identifier_t *id;
+
+    symstack_push_scope(symstack);
+    id = symstack_add_local(symstack, atom);
+
+    // Identifier isn't global
+    TEST_ASSERT_NOT_NULL(id);
+    TEST_ASSERT_EQUAL_STRING("foo", id->name);
+    TEST_ASSERT_EQUAL_PTR(atom, id->atom);
+    TEST_ASSERT_NULL(symtable_find_atom(global, atom));
+    TEST_ASSERT_EQUAL_PTR(id, symstack_find_local(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(id, symstack_add_local(symstack, atom));
+
+    // Nested scope doesn't see it as local
+    symstack_push_scope(symstack);
+    TEST_ASSERT_NULL(symstack_find_local(symstack, atom));
+    symstack_pop_scope(symstack);
+    TEST_ASSERT_EQUAL_PTR(id, symstack_find_local(symstack, atom));
+
+    symstack_pop_scope(symstack);
+    TEST_ASSERT_NULL(symstack_find_local(symstack, atom));
 
-    TEST_ASSERT_NULL(result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_global_symtable_one_table(void)
+void test_symstack_shadowing(void)
 {
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "x", 1);
+    identifier_t *global_x = symstack_add_local(symstack, atom);
+    identifier_t *outer_x;
+    identifier_t *inner_x;
 
-    symstack_push(symstack, t1);
+    global_x->type = VARIABLE;
 
-    result = symstack_global_symtable(symstack);
+    symstack_push_scope(symstack);
+    outer_x = symstack_add_local(symstack, atom);
+    outer_x->type = VARIABLE;
 
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t1, result);
-}
+    symstack_push_scope(symstack);
+    inner_x = symstack_add_local(symstack, atom);
+    inner_x->type = VARIABLE;
 
-void test_symstack_global_symtable_more_tables(void)
-{
-    symstack_t *symstack = symstack_create();
-    symtable_t *result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
-    symtable_t *t3 = symtable_create();
+    TEST_ASSERT_TRUE(inner_x != outer_x);
+    TEST_ASSERT_EQUAL_PTR(inner_x, symstack_find_variable(symstack, atom));
 
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_push(symstack, t3);
+    // Leaving scope gives the name its shadowed binding back
+    symstack_pop_scope(symstack);
+    TEST_ASSERT_EQUAL_PTR(outer_x, symstack_find_variable(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(outer_x, symstack_find_local(symstack, atom));
 
-    result = symstack_global_symtable(symstack);
+    symstack_pop_scope(symstack);
+    TEST_ASSERT_EQUAL_PTR(global_x, symstack_find_variable(symstack, atom));
 
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(t1, result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_is_active_empty(void)
+void test_symstack_find_variable_skips_untyped_identifiers(void)
 {
-    symstack_t *symstack = symstack_create();
-    bool result;
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "y", 1);
+    identifier_t *declared;
+
+    symstack_push_scope(symstack);
+    declared = symstack_add_local(symstack, atom);
+    declared->type = VARIABLE;
+
+    // Identifier was only used in the nested scope (scanner binds all identifiers)
+    symstack_push_scope(symstack);
+    symstack_add_local(symstack, atom);
+    symstack_push_scope(symstack);
+
+    TEST_ASSERT_EQUAL_PTR(declared, symstack_find_variable(symstack, atom));
+
+    // Functions aren't variables
+    symstack_pop_scope(symstack);
+    symstack_pop_scope(symstack);
+    symstack_pop_scope(symstack);
+    symstack_add_local(symstack, atom)->type = FUNCTION;
+    TEST_ASSERT_NULL(symstack_find_variable(symstack, atom));
+    TEST_ASSERT_NULL(symstack_find_variable(symstack, interner_intern(interner, "z", 1)));
 
-    result = symstack_is_active(symstack);
-
-    TEST_ASSERT(!result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_is_active_non_empty_not_active(void)
+void test_symstack_many_names_in_many_scopes(void)
 {
-    symstack_t *symstack = symstack_create();
-    bool result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    identifier_t *ids[20][100];
+    const atom_t *atoms[100];
+    char name[16];
+
+    for (int i = 0; i < 100; i++) {
+        sprintf(name, "name_%d", i);
+        atoms[i] = interner_intern(interner, name, strlen(name));
+    }
+
+    // Scopes are left and entered repeatedly, so the storage is reused
+    for (int round = 0; round < 3; round++) {
+        for (int depth = 0; depth < 20; depth++) {
+            symstack_push_scope(symstack);
+            for (int i = depth; i < 100; i++) {
+                ids[depth][i] = symstack_add_local(symstack, atoms[i]);
+                TEST_ASSERT_NOT_NULL(ids[depth][i]);
+                TEST_ASSERT_EQUAL_INT(0, ids[depth][i]->type);
+                ids[depth][i]->type = VARIABLE;
+                ids[depth][i]->line = depth;
+            }
+        }
+
+        // Identifiers of opened scopes never move
+        for (int depth = 19; depth >= 0; depth--) {
+            for (int i = 0; i < 100; i++) {
+                if (i < depth)
+                    TEST_ASSERT_TRUE(symstack_find_local(symstack, atoms[i]) == NULL);
+                else
+                    TEST_ASSERT_EQUAL_PTR(ids[depth][i], symstack_find_local(symstack, atoms[i]));
+
+                TEST_ASSERT_EQUAL_PTR(ids[i < depth ? i : depth][i], symstack_find_variable(symstack, atoms[i]));
+                TEST_ASSERT_EQUAL_UINT64(i < depth ? i : depth, symstack_find_variable(symstack, atoms[i])->line);
+            }
+
+            symstack_pop_scope(symstack);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(0, global->size);
 
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-
-    result = symstack_is_active(symstack);
-
-    TEST_ASSERT(!result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_is_active_non_empty_active(void)
+void test_symstack_destroy_with_opened_scopes(void)
 {
-    symstack_t *symstack = symstack_create();
-    bool result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
 
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_most_local(symstack);
+    symstack_push_scope(symstack);
+    symstack_add_local(symstack, interner_intern(interner, "a", 1));
+    symstack_push_scope(symstack);
+    symstack_add_local(symstack, interner_intern(interner, "b", 1));
 
-    result = symstack_is_active(symstack);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 
-    TEST_ASSERT(result);
+    TEST_PASS();
 }
 
-void test_symstack_is_active_pop_active_table(void)
+void test_symstack_global_scope_contains_builtins(void)
 {
-    symstack_t *symstack = symstack_create();
-    bool result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
-
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_most_local(symstack);
-    symstack_pop(symstack);
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "write", 5);
+    identifier_t *write = symstack_find_global(symstack, atom);
+
+    // Builtins are found (with the atom of their name), but they aren't added to the global table
+    TEST_ASSERT_NOT_NULL(write);
+    TEST_ASSERT_EQUAL_INT(FUNCTION, write->type);
+    TEST_ASSERT_EQUAL_PTR(atom, write->atom);
+    TEST_ASSERT_EQUAL_PTR(write, symstack_find_global(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(write, symstack_find_local(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(write, symstack_add_local(symstack, atom));
+    TEST_ASSERT_EQUAL_UINT64(0, global->size);
+
+    // Block scopes get their own identifiers
+    symstack_push_scope(symstack);
+    TEST_ASSERT_NULL(symstack_find_local(symstack, atom));
+    TEST_ASSERT_TRUE(symstack_add_local(symstack, atom) != write);
+    TEST_ASSERT_EQUAL_PTR(write, symstack_find_global(symstack, atom));
+    TEST_ASSERT_NULL(symstack_find_variable(symstack, atom));
 
-    result = symstack_is_active(symstack);
-
-    TEST_ASSERT(!result);
+    symstack_destroy(symstack);
+    symtable_destroy(global);
 }
 
-void test_symstack_is_active_next_overflow(void)
+void test_symstack_deep_nesting(void)
 {
-    symstack_t *symstack = symstack_create();
-    bool result;
-    symtable_t *t1 = symtable_create();
-    symtable_t *t2 = symtable_create();
+    symtable_t *global = symtable_create();
+    symstack_t *symstack = symstack_create(global);
+    const atom_t *atom = interner_intern(interner, "deep", 4);
+    identifier_t *ids[1000];
 
-    symstack_push(symstack, t1);
-    symstack_push(symstack, t2);
-    symstack_most_local(symstack);
-    symstack_next(symstack);
-    symstack_next(symstack);
+    // Stack of scopes grows over its initial capacity, the global table stays at the bottom
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, symstack_push_scope(symstack));
+        ids[i] = symstack_add_local(symstack, atom);
+        ids[i]->type = VARIABLE;
+        TEST_ASSERT_EQUAL_PTR(global, symstack_global_symtable(symstack));
+    }
 
-    result = symstack_is_active(symstack);
+    TEST_ASSERT_EQUAL_UINT64(1000, symstack_depth(symstack));
 
-    TEST_ASSERT(!result);
-}
+    for (int i = 999; i >= 0; i--) {
+        TEST_ASSERT_EQUAL_PTR(ids[i], symstack_find_variable(symstack, atom));
+        TEST_ASSERT_EQUAL_INT(0, symstack_pop_scope(symstack));
+    }
 
-void test_symstack_destroy(void)
-{
-    symstack_t *symstack = symstack_create();
+    TEST_ASSERT_NULL(symstack_find_variable(symstack, atom));
+    TEST_ASSERT_EQUAL_PTR(global, symstack_global_symtable(symstack));
 
     symstack_destroy(symstack);
-
-    TEST_PASS();
+    symtable_destroy(global);
 }
@@ -1,6 +1,8 @@
 #include "../../unity/src/unity.h"
 #include "../../src/symtable.h"
 
+#include <stdio.h>
+
 void test_create()
 {
     symtable_t *t1 = symtable_create();
@@ -100,9 +102,9 @@ void test_check_new_identifier_properties_are_zero()
     TEST_ASSERT_EQUAL_INT(0, id->var.type);
     TEST_ASSERT_EQUAL_INT(0, id->var.init);
     TEST_ASSERT_EQUAL_INT(0, id->var.used);
-    TEST_ASSERT_EQUAL_INT(0, id->fun.defined);
-    TEST_ASSERT_NULL(id->fun.param);
-    TEST_ASSERT_NULL(id->fun.retval);
+    TEST_ASSERT_EQUAL_INT(0, id->defined);
+    TEST_ASSERT_EQUAL_INT(0, id->fun.param.len);
+    TEST_ASSERT_EQUAL_INT(0, id->fun.retval.len);
 }
 
 void test_check_retrieved_variable_identifier_properties()
@@ -135,15 +137,21 @@ void test_check_retrieved_function_identifier_properties()
     int line = 1;
     int character = 1;
     int defined = 1;
-    char *param = "ssis";
-    char *retval = "";
+    signature_t param = SIGNATURE(0, 0);
+    signature_t retval = SIGNATURE(0, 0);
+    char buffer[SIGNATURE_BUFFER_SIZE];
     symtable_t *t = symtable_create();
     identifier_t *id = symtable_add(t, "foo");
 
+    signature_append(NULL, &param, VAR_STRING);
+    signature_append(NULL, &param, VAR_STRING);
+    signature_append(NULL, &param, VAR_INTEGER);
+    signature_append(NULL, &param, VAR_STRING);
+
     id->line = line;
     id->character = character;
     id->type = FUNCTION;
-    id->fun.defined = defined;
+    id->defined = defined;
     id->fun.param = param;
     id->fun.retval = retval;
 
@@ -152,10 +160,195 @@ void test_check_retrieved_function_identifier_properties()
     TEST_ASSERT_EQUAL_INT(check->line, line);
     TEST_ASSERT_EQUAL_INT(check->character, character);
     TEST_ASSERT_EQUAL_INT(check->type, FUNCTION);
-    TEST_ASSERT_EQUAL_INT(check->fun.defined, defined);
-    TEST_ASSERT_NOT_NULL(check->fun.param);
-    TEST_ASSERT_NOT_NULL(check->fun.retval);
-    TEST_ASSERT_EQUAL_STRING(check->fun.param, param);
-    TEST_ASSERT_EQUAL_STRING(check->fun.retval, retval);
+    TEST_ASSERT_EQUAL_INT(check->defined, defined);
+    TEST_ASSERT_TRUE(signature_equal(check->fun.param, param));
+    TEST_ASSERT_TRUE(signature_equal(check->fun.retval, retval));
+    TEST_ASSERT_EQUAL_STRING("ssis", signature_format(check->fun.param, buffer));
+    TEST_ASSERT_EQUAL_STRING("", signature_format(check->fun.retval, buffer));
+}
+
+
+void test_find_name_by_atom()
+{
+    interner_t *interner = interner_create();
+    symtable_t *t1 = symtable_create();
+    symtable_t *t2 = symtable_create();
+    const atom_t *atom = interner_intern(interner, "foo", 3);
+
+    identifier_t *id1 = symtable_add_atom(t1, atom);
+    identifier_t *id2 = symtable_add_atom(t2, atom);
+
+    // Identifiers in different tables share the atom
+    TEST_ASSERT_NOT_NULL(id1);
+    TEST_ASSERT_NOT_NULL(id2);
+    TEST_ASSERT_TRUE(id1 != id2);
+    TEST_ASSERT_EQUAL_PTR(atom, id1->atom);
+    TEST_ASSERT_EQUAL_PTR(atom, id2->atom);
+    TEST_ASSERT_EQUAL_PTR(atom->name, id2->name);
+    TEST_ASSERT_EQUAL_PTR(id1, symtable_find_atom(t1, atom));
+    TEST_ASSERT_EQUAL_PTR(id2, symtable_find_atom(t2, atom));
+    TEST_ASSERT_EQUAL_PTR(id1, symtable_find(t1, "foo"));
+    TEST_ASSERT_NULL(symtable_find_atom(t1, interner_intern(interner, "bar", 3)));
+
+    // Name is found regardless of the way it was added
+    TEST_ASSERT_EQUAL_PTR(id1, symtable_add(t1, "foo"));
+    TEST_ASSERT_EQUAL_UINT64(1, t1->size);
+
+    symtable_destroy(t1);
+    symtable_destroy(t2);
+    interner_destroy(interner);
+}
+
+void test_add_many_names_to_table()
+{
+    symtable_t *t = symtable_create();
+    identifier_t **ids = malloc(100000 * sizeof(identifier_t *));
+    char name[32];
+
+    // Table has to grow many times
+    for (int i = 0; i < 100000; i++) {
+        sprintf(name, "var_%d", i);
+        ids[i] = symtable_add(t, name);
+
+        TEST_ASSERT_NOT_NULL(ids[i]);
+        ids[i]->line = i;
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(100000, t->size);
+    TEST_ASSERT_TRUE(4 * t->size <= 3 * t->capacity);
+
+    // Identifiers don't move when table grows
+    for (int i = 0; i < 100000; i++) {
+        sprintf(name, "var_%d", i);
+
+        TEST_ASSERT_EQUAL_PTR(ids[i], symtable_find(t, name));
+        TEST_ASSERT_EQUAL_PTR(ids[i], symtable_add(t, name));
+        TEST_ASSERT_EQUAL_STRING(name, ids[i]->name);
+        TEST_ASSERT_EQUAL_UINT64(i, ids[i]->line);
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(100000, t->size);
+    TEST_ASSERT_NULL(symtable_find(t, "var_100000"));
+    TEST_ASSERT_NULL(symtable_find(t, "var_-1"));
+
+    free(ids);
+    symtable_destroy(t);
+}
+
+void test_many_tables_with_the_same_names()
+{
+    symtable_t *tables[8];
+    identifier_t *id;
+    char name[32];
+
+    for (int j = 0; j < 8; j++)
+        tables[j] = symtable_create();
+
+    // Tables are independent even if they contain the same names
+    for (int i = 0; i < 20000; i++) {
+        sprintf(name, "id%d", i);
+        for (int j = 0; j < 8; j++) {
+            if (i % (j + 1) == 0) {
+                id = symtable_add(tables[j], name);
+                id->character = j;
+            }
+        }
+    }
+
+    for (int i = 0; i < 20000; i++) {
+        sprintf(name, "id%d", i);
+        for (int j = 0; j < 8; j++) {
+            id = symtable_find(tables[j], name);
+            if (i % (j + 1) == 0) {
+                TEST_ASSERT_NOT_NULL(id);
+                TEST_ASSERT_EQUAL_UINT64(j, id->character);
+            } else {
+                TEST_ASSERT_NULL(id);
+            }
+        }
+    }
+
+    for (int j = 0; j < 8; j++) {
+        TEST_ASSERT_EQUAL_UINT64((20000 + j) / (j + 1), tables[j]->size);
+        symtable_destroy(tables[j]);
+    }
+}
+
+void test_slots_keep_hash_and_length()
+{
+    symtable_t *t = symtable_create();
+    const char *names[] = {"a", "ab", "abc", "x_1", "longer_identifier_name", ""};
+    size_t found = 0;
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(*names); i++)
+        symtable_add(t, names[i]);
+
+    for (size_t i = 0; i < t->capacity; i++) {
+        if (!t->slots[i].identifier)
+            continue;
+
+        found++;
+        TEST_ASSERT_EQUAL_HEX32(interner_hash(t->slots[i].identifier->name, strlen(t->slots[i].identifier->name)),
+                                t->slots[i].hash);
+        TEST_ASSERT_EQUAL_UINT32(strlen(t->slots[i].identifier->name), t->slots[i].len);
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(sizeof(names) / sizeof(*names), found);
+    TEST_ASSERT_NULL(symtable_find(t, "abcd"));
+    TEST_ASSERT_NULL(symtable_find(t, "never_interned_name"));
+
+    symtable_destroy(t);
+}
+
+void test_arena_table()
+{
+    symtable_t *t = symtable_create_arena();
+    identifier_t *ids[1000];
+    char name[16];
+
+    TEST_ASSERT_NOT_NULL(t);
+
+    // Identifiers don't move when the arena needs more chunks
+    for (int i = 0; i < 1000; i++) {
+        sprintf(name, "id_%d", i);
+        ids[i] = symtable_add(t, name);
+        TEST_ASSERT_NOT_NULL(ids[i]);
+        TEST_ASSERT_EQUAL_INT(0, ids[i]->type);
+        ids[i]->type = FUNCTION;
+        ids[i]->line = i;
+    }
+
+    TEST_ASSERT_NOT_NULL(t->arena->next);
+    for (int i = 0; i < 1000; i++) {
+        sprintf(name, "id_%d", i);
+        TEST_ASSERT_EQUAL_PTR(ids[i], symtable_find(t, name));
+        TEST_ASSERT_EQUAL_INT(FUNCTION, ids[i]->type);
+        TEST_ASSERT_EQUAL_UINT64(i, ids[i]->line);
+    }
+
+    symtable_destroy(t);
 }
 
+void test_clear_arena_table()
+{
+    symtable_t *t = symtable_create_arena();
+    struct symtable_chunk *first = t->arena;
+    identifier_t *id;
+
+    id = symtable_add(t, "foo");
+    id->type = FUNCTION;
+    id->defined = 1;
+
+    // Arena is reset and its first chunk is used again
+    symtable_clear(t);
+    TEST_ASSERT_EQUAL_UINT64(0, t->size);
+    TEST_ASSERT_NULL(symtable_find(t, "foo"));
+    TEST_ASSERT_EQUAL_PTR(first, t->arena);
+    TEST_ASSERT_EQUAL_UINT64(0, t->arena->used);
+
+    TEST_ASSERT_EQUAL_PTR(id, symtable_add(t, "bar"));
+    TEST_ASSERT_EQUAL_INT(0, id->type);
+    TEST_ASSERT_EQUAL_INT(0, id->defined);
+
+    symtable_destroy(t);
+}
@@ -0,0 +1,435 @@
+#include "../../unity/src/unity.h"
+#include "../../src/tokcache.h"
+#include "../../src/scanner.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Interner of names used by the tests (each test has its own one)
+ */
+static interner_t *interner;
+
+void setUp(void)
+{
+    interner = interner_create();
+}
+
+void tearDown(void)
+{
+    interner_destroy(interner);
+}
+
+/**
+ * Program used for scanning (all kinds of tokens, repeated identifiers)
+ */
+static const char *program =
+        "require \"ifj21\"\n"
+        "function main(n : integer) : number\n"
+        "    local s : string = \"text with\\t#escapes\\065\" .. \"\"\n"
+        "    local x : number = 1.5e-3 + n // 2 * 42 - #s\n"
+        "    if x >= 3 and n ~= nil then return x else return 0.1 end\n"
+        "end\n"
+        "main(n)\n";
+
+/**
+ * Creates context with dependencies of scanner
+ *
+ * @param input Input to scan
+ * @return Context prepared for scanning
+ */
+static context_t *create_scanner_context(const char *input)
+{
+    context_t *context = malloc(sizeof(context_t));
+
+    context->symstack = symstack_create(symtable_create());
+    context->kwtable = kwtable_create();
+    context->string = string_create();
+    context->scanner = scanner_create(source_from_memory(input, strlen(input)));
+    context->literals = NULL;
+    context->interner = interner;
+
+    return context;
+}
+
+/**
+ * Destroys context with dependencies of scanner
+ *
+ * @param context Context to destroy
+ */
+static void destroy_scanner_context(context_t *context)
+{
+    symtable_t *global = symstack_global_symtable(context->symstack);
+
+    symstack_destroy(context->symstack);
+    symtable_destroy(global);
+    kwtable_destroy(context->kwtable);
+    string_destroy(context->string);
+    scanner_destroy(context->scanner);
+    free(context);
+}
+
+/**
+ * Scans the program and writes its tokens into a temporary file
+ *
+ * @param input Program to scan
+ * @return Rewound cache file
+ */
+static FILE *create_cache_file(const char *input)
+{
+    context_t *context = create_scanner_context(input);
+    FILE *file = tmpfile();
+    token_t token;
+
+    TEST_ASSERT_NOT_NULL(file);
+
+    context->scanner->cache_writer = tokcache_writer_create();
+    do {
+        token = get_next_token(context);
+        if (token.type == STRING)
+            free(token.string);
+    } while (token.type != END);
+
+    TEST_ASSERT_EQUAL_INT(0, tokcache_writer_save(context->scanner->cache_writer, file, context->scanner->source));
+    rewind(file);
+
+    destroy_scanner_context(context);
+
+    return file;
+}
+
+/**
+ * Writes bytes into a temporary file
+ *
+ * @param bytes Content of the file
+ * @param len Length of the content
+ * @return Rewound file
+ */
+static FILE *create_file(const char *bytes, size_t len)
+{
+    FILE *file = tmpfile();
+
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL_UINT64(len, fwrite(bytes, 1, len, file));
+    rewind(file);
+
+    return file;
+}
+
+/**
+ * Creates cache file for the program with the given body (name table and tokens) and correct header
+ *
+ * @param body Body of the cache file
+ * @param len Length of the body
+ * @return Rewound cache file
+ */
+static FILE *create_cache_file_with_body(const char *body, size_t len)
+{
+    source_t *source = source_from_memory(program, strlen(program));
+    source_t *body_source = source_from_memory(body, len);
+    uint64_t fields[3] = {tokcache_hash(source), strlen(program), tokcache_hash(body_source)};
+    char bytes[256];
+    size_t n = 0;
+
+    memcpy(bytes, TOKCACHE_MAGIC, strlen(TOKCACHE_MAGIC));
+    n += strlen(TOKCACHE_MAGIC);
+    bytes[n++] = TOKCACHE_VERSION;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 8; j++)
+            bytes[n++] = (char) (fields[i] >> (8 * j));
+    }
+    memcpy(bytes + n, body, len);
+    n += len;
+
+    source_destroy(source);
+    source_destroy(body_source);
+
+    return create_file(bytes, n);
+}
+
+void test_tokcache_hash(void)
+{
+    source_t *first = source_from_memory("local a : integer", 17);
+    source_t *second = source_from_memory("local b : integer", 17);
+    source_t *third = source_from_memory("local a : integer", 16);
+
+    TEST_ASSERT_TRUE(tokcache_hash(first) != tokcache_hash(second));
+    TEST_ASSERT_TRUE(tokcache_hash(first) != tokcache_hash(third));
+    TEST_ASSERT_TRUE(tokcache_hash(first) == tokcache_hash(first));
+
+    source_destroy(first);
+    source_destroy(second);
+    source_destroy(third);
+}
+
+void test_tokcache_write_and_read(void)
+{
+    source_t *source = source_from_memory("src", 3);
+    tokcache_writer_t *writer = tokcache_writer_create();
+    tokcache_reader_t *reader;
+    FILE *file = tmpfile();
+    const atom_t *foo = interner_intern(interner, "foo", 3);
+    const atom_t *bar = interner_intern(interner, "bar", 3);
+    tokcache_token_t tokens[] = {
+            {.type = KEYWORD, .keyword = KW_WHILE},
+            {.type = IDENTIFIER, .identifier = {foo, 1, 7}},
+            {.type = IDENTIFIER, .identifier = {bar, 300, UINT32_MAX}},
+            {.type = IDENTIFIER, .identifier = {foo, 2, 1}},
+            {.type = INTEGER, .integer = -123456},
+            {.type = NUMBER, .number = 0.1},
+            {.type = STRING, .string = {"a\\032b", 6}},
+            {.type = STRING, .string = {"", 0}},
+            {.type = CONCAT},
+            {.type = END},
+    };
+    tokcache_token_t token;
+
+    TEST_ASSERT_NOT_NULL(writer);
+    for (size_t i = 0; i < sizeof(tokens) / sizeof(*tokens); i++)
+        TEST_ASSERT_EQUAL_INT(0, tokcache_writer_add(writer, &tokens[i]));
+    TEST_ASSERT_EQUAL_INT(0, tokcache_writer_save(writer, file, source));
+    rewind(file);
+
+    reader = tokcache_reader_open(file, source, interner);
+    TEST_ASSERT_NOT_NULL(reader);
+
+    for (size_t i = 0; i < sizeof(tokens) / sizeof(*tokens); i++) {
+        TEST_ASSERT_EQUAL_INT(0, tokcache_reader_next(reader, &token));
+        TEST_ASSERT_EQUAL_INT(tokens[i].type, token.type);
+    }
+
+    // Values have to stay the same (identifiers have the same atoms)
+    rewind(file);
+    tokcache_reader_destroy(reader);
+    reader = tokcache_reader_open(file, source, interner);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_INT(KW_WHILE, token.keyword);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_PTR(foo, token.identifier.atom);
+    TEST_ASSERT_EQUAL_UINT64(1, token.identifier.line);
+    TEST_ASSERT_EQUAL_UINT64(7, token.identifier.character);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_PTR(bar, token.identifier.atom);
+    TEST_ASSERT_EQUAL_UINT64(300, token.identifier.line);
+    TEST_ASSERT_EQUAL_UINT64(UINT32_MAX, token.identifier.character);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_PTR(foo, token.identifier.atom);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_INT(-123456, token.integer);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_MEMORY(&tokens[5].number, &token.number, sizeof(double));
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_UINT64(6, token.string.len);
+    TEST_ASSERT_EQUAL_MEMORY("a\\032b", token.string.chars, 6);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_UINT64(0, token.string.len);
+
+    // END is returned repeatedly
+    tokcache_reader_next(reader, &token);
+    tokcache_reader_next(reader, &token);
+    TEST_ASSERT_EQUAL_INT(END, token.type);
+    TEST_ASSERT_EQUAL_INT(0, tokcache_reader_next(reader, &token));
+    TEST_ASSERT_EQUAL_INT(END, token.type);
+
+    tokcache_reader_destroy(reader);
+    tokcache_writer_destroy(writer);
+    source_destroy(source);
+    fclose(file);
+}
+
+void test_tokcache_incomplete_stream_is_not_saved(void)
+{
+    source_t *source = source_from_memory("src", 3);
+    tokcache_writer_t *writer = tokcache_writer_create();
+    tokcache_token_t token = {.type = COMMA};
+    FILE *file = tmpfile();
+
+    tokcache_writer_add(writer, &token);
+
+    TEST_ASSERT_TRUE(tokcache_writer_save(writer, file, source) < 0);
+
+    tokcache_writer_destroy(writer);
+    source_destroy(source);
+    fclose(file);
+}
+
+void test_tokcache_stale_cache(void)
+{
+    FILE *file = create_cache_file(program);
+    char *changed = malloc(strlen(program) + 1);
+    source_t *source;
+
+    // Every change of the source makes cache unusable
+    strcpy(changed, program);
+    changed[strlen(changed) - 3] = 'x';
+    source = source_from_memory(changed, strlen(changed));
+
+    TEST_ASSERT_NULL(tokcache_reader_open(file, source, interner));
+
+    source_destroy(source);
+    free(changed);
+    fclose(file);
+}
+
+void test_tokcache_stale_cache_same_words(void)
+{
+    FILE *file = create_cache_file(program);
+    char *changed = malloc(strlen(program) + 1);
+    size_t start = strstr(program, "text with") - program;
+    size_t i = start + (7 - start % 8 + 8) % 8;
+    source_t *source;
+
+    // Highest bits of two bytes 8 bytes apart (same position in two 8-byte words) within the string literal
+    TEST_ASSERT_TRUE(i + 8 < (size_t) (strstr(program, "\" ..") - program));
+    strcpy(changed, program);
+    changed[i] ^= (char) 0x80;
+    changed[i + 8] ^= (char) 0x80;
+    source = source_from_memory(changed, strlen(changed));
+
+    TEST_ASSERT_NULL(tokcache_reader_open(file, source, interner));
+
+    source_destroy(source);
+    free(changed);
+    fclose(file);
+}
+
+void test_tokcache_invalid_file(void)
+{
+    source_t *source = source_from_memory(program, strlen(program));
+    FILE *empty = tmpfile();
+    FILE *other = tmpfile();
+
+    fputs("IFJ21TOX and something else, which looks like a header", other);
+    rewind(other);
+
+    TEST_ASSERT_NULL(tokcache_reader_open(empty, source, interner));
+    TEST_ASSERT_NULL(tokcache_reader_open(other, source, interner));
+
+    source_destroy(source);
+    fclose(empty);
+    fclose(other);
+}
+
+void test_tokcache_damaged_body(void)
+{
+    FILE *file = create_cache_file(program);
+    source_t *source = source_from_memory(program, strlen(program));
+    tokcache_reader_t *reader;
+    FILE *damaged;
+    char bytes[4096];
+    size_t len = fread(bytes, 1, sizeof(bytes), file);
+    char message[32];
+
+    // Valid cache is accepted
+    rewind(file);
+    reader = tokcache_reader_open(file, source, interner);
+    TEST_ASSERT_NOT_NULL(reader);
+    tokcache_reader_destroy(reader);
+
+    // Any change of the body (behind the header of 33 bytes) is detected
+    for (size_t i = 33; i < len; i++) {
+        sprintf(message, "byte %zu", i);
+        bytes[i] ^= 0x10;
+        damaged = create_file(bytes, len);
+        TEST_ASSERT_NULL_MESSAGE(tokcache_reader_open(damaged, source, interner), message);
+        fclose(damaged);
+        bytes[i] ^= 0x10;
+    }
+
+    // Truncated file, too
+    damaged = create_file(bytes, len - 1);
+    TEST_ASSERT_NULL(tokcache_reader_open(damaged, source, interner));
+    fclose(damaged);
+
+    source_destroy(source);
+    fclose(file);
+}
+
+void test_tokcache_invalid_token_stream(void)
+{
+    source_t *source = source_from_memory(program, strlen(program));
+    // No names, END
+    const char valid[] = {0, END};
+    // No names, INTEGER with 2 of 4 bytes
+    const char incomplete[] = {0, INTEGER, 1, 2};
+    // No names, IDENTIFIER with index out of the name table
+    const char unknown_name[] = {0, IDENTIFIER, 0, 1, 1, END};
+    // No names, bytes after END
+    const char trailing[] = {0, END, END};
+    // Name "a", IDENTIFIER with line 2^32
+    const char long_line[] = {1, 1, 'a', IDENTIFIER, 0, (char) 0x80, (char) 0x80, (char) 0x80, (char) 0x80, 0x10, 1, END};
+    const char *bodies[] = {incomplete, unknown_name, trailing, long_line};
+    const size_t lengths[] = {sizeof(incomplete), sizeof(unknown_name), sizeof(trailing), sizeof(long_line)};
+    tokcache_reader_t *reader;
+    tokcache_token_t token;
+    FILE *file;
+
+    file = create_cache_file_with_body(valid, sizeof(valid));
+    reader = tokcache_reader_open(file, source, interner);
+    TEST_ASSERT_NOT_NULL(reader);
+    TEST_ASSERT_EQUAL_INT(0, tokcache_reader_next(reader, &token));
+    TEST_ASSERT_EQUAL_INT(END, token.type);
+    tokcache_reader_destroy(reader);
+    fclose(file);
+
+    // Checksums are correct, but the streams can't be read to the end
+    for (size_t i = 0; i < sizeof(bodies) / sizeof(*bodies); i++) {
+        file = create_cache_file_with_body(bodies[i], lengths[i]);
+        TEST_ASSERT_NULL(tokcache_reader_open(file, source, interner));
+        fclose(file);
+    }
+
+    source_destroy(source);
+}
+
+void test_tokcache_replay_matches_scanning(void)
+{
+    FILE *file = create_cache_file(program);
+    context_t *scanned = create_scanner_context(program);
+    context_t *replayed = create_scanner_context(program);
+    token_t expected;
+    token_t result;
+    char message[32];
+    int index = 0;
+
+    replayed->scanner->cache_reader = tokcache_reader_open(file, replayed->scanner->source, interner);
+    TEST_ASSERT_NOT_NULL(replayed->scanner->cache_reader);
+
+    do {
+        expected = get_next_token(scanned);
+        result = get_next_token(replayed);
+        sprintf(message, "token %d", index++);
+
+        TEST_ASSERT_EQUAL_INT_MESSAGE(expected.type, result.type, message);
+        switch (expected.type) {
+            case IDENTIFIER:
+                // Identifiers are bound to the tables of symbols like when scanning
+                TEST_ASSERT_EQUAL_PTR_MESSAGE(expected.identifier->atom, result.identifier->atom, message);
+                TEST_ASSERT_EQUAL_UINT64_MESSAGE(expected.identifier->line, result.identifier->line, message);
+                TEST_ASSERT_EQUAL_UINT64_MESSAGE(
+                        expected.identifier->character, result.identifier->character, message
+                );
+                break;
+            case KEYWORD:
+                TEST_ASSERT_EQUAL_INT_MESSAGE(*expected.keyword, *result.keyword, message);
+                break;
+            case INTEGER:
+                TEST_ASSERT_EQUAL_INT_MESSAGE(expected.integer, result.integer, message);
+                break;
+            case NUMBER:
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected.number, &result.number, sizeof(double), message);
+                break;
+            case STRING:
+                TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.string, result.string, message);
+                free(expected.string);
+                free(result.string);
+                break;
+            default:
+                break;
+        }
+    } while (expected.type != END);
+
+    destroy_scanner_context(scanned);
+    destroy_scanner_context(replayed);
+    fclose(file);
+}